@@ -0,0 +1,131 @@
+/**
+ * @brief: This file contains the declaration of the AmbiguityChecker class, which searches for a string with two
+ * derivations up to a length bound
+ * @author: Emir Murat
+ * @date: 18/10/2026
+ */
+
+#ifndef CFG_AMBIGUITYCHECKER_H
+#define CFG_AMBIGUITYCHECKER_H
+
+#include <cstdint>
+
+#include "IndexedGrammar.h"
+#include "ViterbiParser.h"
+
+/**
+ * The result of an ambiguity check
+ */
+struct AmbiguityReport {
+    bool ambiguous = false;
+    /**
+     * True if the entry budget ran out before max_length was reached
+     */
+    bool budget_exceeded = false;
+    /**
+     * All strings up to this length were checked (none if the budget ran out at length 0)
+     */
+    std::size_t checked_length = 0;
+    /**
+     * A shortest string with two derivations (the first one in terminal order)
+     */
+    std::string witness;
+    /**
+     * Two distinct derivations of the witness from the start symbol
+     */
+    ParseTree first;
+    ParseTree second;
+};
+
+class AmbiguityChecker {
+
+private:
+
+    /**
+     * One way a variable derives a string: the production and the length of the part of every body symbol
+     */
+    struct Way {
+        int production;
+        std::vector<std::size_t> lengths;
+
+        bool operator==(const Way &other) const {
+            return production == other.production && lengths == other.lengths;
+        }
+    };
+
+    /**
+     * The number of derivations of a string from a variable, saturated at 2, and the first two ways that were found
+     */
+    struct Derivations {
+        std::uint8_t count = 0;
+        std::vector<Way> ways;
+    };
+
+    /**
+     * The strings of one length that a variable derives, every terminal is stored as one character (its index)
+     */
+    using Layer = std::map<std::string, Derivations>;
+
+    /**
+     * table[length][variable]
+     */
+    using Table = std::vector<std::vector<Layer>>;
+
+    IndexedGrammar grammar;
+
+    /**
+     * True if a variable can take the whole length of one of its bodies (the other symbols derive the empty
+     * string), then a layer depends on itself and is computed in rounds
+     */
+    bool self_dependent = false;
+
+public:
+
+    /**
+     * The default maximum number of (variable, string) entries in the table
+     */
+    static constexpr std::size_t default_max_entries = 1000000;
+
+    /**
+     * @param cfg the CFG, productions of any form (epsilon and unit productions included)
+     * @throws std::runtime_error if the CFG has more than 256 terminals
+     */
+    explicit AmbiguityChecker(const CFG &cfg);
+
+    /**
+     * Counts the derivations of every string up to max_length with a dynamic program over (variable, length):
+     * a layer stores the strings of that length a variable derives and their number of derivations, saturated
+     * at 2, and is built from the shorter layers, so derivations are never enumerated. A single count per
+     * (variable, length) would mix the derivations of different strings, so the strings themselves are kept and
+     * the table grows with the number of derived strings (up to |terminals|^max_length); the entry budget
+     * bounds it. A layer depends on all shorter ones, and on itself through nullable siblings and unit
+     * productions, it is then computed in rounds until it is stable; within a round the variables are split
+     * over threads.
+     * @param max_length the longest string that is checked
+     * @param thread_count the number of worker threads
+     * @param max_entries the maximum number of (variable, string) entries, the check stops at the first length
+     * that would exceed it and reports budget_exceeded
+     * @return the first (shortest) string with two derivations from the start symbol and both derivations
+     */
+    [[nodiscard]] AmbiguityReport check(std::size_t max_length, unsigned int thread_count = 1,
+                                        std::size_t max_entries = default_max_entries) const;
+
+private:
+
+    /**
+     * Computes a layer of a variable from scratch, reading the table of the previous round
+     * @param limit the layer stops growing once it holds more than limit strings
+     */
+    [[nodiscard]] Layer derive(const Table &table, int variable, std::size_t length,
+                               const std::vector<std::size_t> &min_lengths, std::size_t limit) const;
+
+    /**
+     * Rebuilds a derivation of a string
+     * @param second false for the first recorded derivation, true for one that differs from it
+     */
+    [[nodiscard]] ParseTree derivation(const Table &table, int symbol, const std::string &word, bool second) const;
+
+};
+
+
+#endif //CFG_AMBIGUITYCHECKER_H
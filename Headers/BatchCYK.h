@@ -0,0 +1,47 @@
+/**
+ * @brief: This file contains the declaration of the BatchCYK class, which recognizes many inputs that share prefixes
+ * @author: Emir Murat
+ * @date: 18/10/2026
+ */
+
+#ifndef CFG_BATCHCYK_H
+#define CFG_BATCHCYK_H
+
+#include "IncrementalCYK.h"
+
+class BatchCYK {
+
+private:
+
+    IncrementalCYK cyk;
+
+    /**
+     * Number of chart columns computed by the last batch
+     */
+    std::size_t columns = 0;
+
+public:
+
+    /**
+     * @param cfg a CFG in Chomsky normal form
+     * @throws std::runtime_error if the CFG is not in Chomsky normal form
+     */
+    explicit BatchCYK(const CFG &cfg);
+
+    /**
+     * Loads the inputs into a trie and walks it depth first with an IncrementalCYK: a column is pushed when
+     * the walk goes down an edge and popped when it backtracks, so the columns of a shared prefix are computed once
+     * @param inputs the input strings, every character is a terminal
+     * @return for every input, true if the CFG accepts it
+     */
+    std::vector<bool> accepts(const std::vector<std::string> &inputs);
+
+    /**
+     * @return the number of chart columns computed by the last batch (the number of trie edges)
+     */
+    [[nodiscard]] std::size_t getColumnCount() const;
+
+};
+
+
+#endif //CFG_BATCHCYK_H
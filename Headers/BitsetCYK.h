@@ -0,0 +1,37 @@
+/**
+ * @brief: This file contains the declaration of the BitsetCYK class, a CYK recognizer with bitset cells
+ * @author: Emir Murat
+ * @date: 18/10/2026
+ */
+
+#ifndef CFG_BITSETCYK_H
+#define CFG_BITSETCYK_H
+
+#include "CNFGrammar.h"
+
+class BitsetCYK {
+
+private:
+
+    CNFGrammar grammar;
+
+public:
+
+    /**
+     * @param cfg a CFG in Chomsky normal form
+     * @throws std::runtime_error if the CFG is not in Chomsky normal form
+     */
+    explicit BitsetCYK(const CFG &cfg);
+
+    /**
+     * Runs CYK over a flat chart of VariableSets, a split only looks at the binary rules of the
+     * variables that are in the left cell
+     * @param input the input string, every character is a terminal
+     * @return true if the input is accepted else false
+     */
+    [[nodiscard]] bool accepts(const std::string &input) const;
+
+};
+
+
+#endif //CFG_BITSETCYK_H
@@ -15,12 +15,19 @@
 #include <iostream>
 #include <iomanip>
 #include <fstream>
+#include <memory>
+#include <mutex>
+#include <cstdint>
 #include "json.hpp"
 #include "Logger.h"
 
 using StringSet = std::set<std::string>;
 using json = nlohmann::json;
 
+class PDA;
+class Recognizer;
+class MembershipCache;
+
 struct ParseTable {
 
     std::map<std::string, std::map<std::string, std::string>> Table;
@@ -37,6 +44,11 @@ struct ParseTable {
 
     bool firstSetAdded;
 
+    /**
+     * True if two different productions were set for the same variable and symbol
+     */
+    bool conflicts = false;
+
     ParseTable(const StringSet &variables, StringSet symbols);
 
     void setParseRule(const std::string &variable, const std::string &symbol, const std::string &production);
@@ -104,6 +116,21 @@ StringSet cartesianProduct(const StringSet &set1, const StringSet &set2);
  */
 StringSet findExistingRule(const std::string &terminal, const std::map<std::string, StringSet> &productions);
 
+/**
+ * A mutex that can be a member of a copyable class: a copy gets its own, unlocked mutex
+ */
+struct CopyableMutex {
+    std::mutex mutex;
+
+    CopyableMutex() = default;
+
+    CopyableMutex(const CopyableMutex &) {}
+
+    CopyableMutex &operator=(const CopyableMutex &) {
+        return *this;
+    }
+};
+
 
 class CFG {
 
@@ -124,11 +151,43 @@ private:
      */
     std::map<std::string, StringSet> production_rules;
 
+    /**
+     * Probabilities of the production rules (head -> body -> probability), only for the productions that have one
+     */
+    std::map<std::string, std::map<std::string, double>> probabilities;
+
     /**
      * Start symbol of the CFG
      */
     std::string start_symbol;
 
+    /**
+     * The membership engine of the CFG, picked by the first call to recognize.
+     * Read and published with std::atomic_load and std::atomic_store, so threads can share a CFG
+     */
+    std::shared_ptr<Recognizer> recognizer;
+
+    /**
+     * Fingerprint of the grammar the recognizer was built for, separates the results in a shared cache
+     */
+    std::uint64_t fingerprint = 0;
+
+    /**
+     * LRU cache of membership results in front of the recognizer, created together with the first recognizer
+     * unless caching is turned off, null until then
+     */
+    std::shared_ptr<MembershipCache> cache;
+
+    /**
+     * False if caching was turned off with setCache(nullptr)
+     */
+    bool caching = true;
+
+    /**
+     * Serializes building the recognizer (and the cache) when threads call recognize at the same time
+     */
+    CopyableMutex recognizer_mutex;
+
 public:
 
     /**
@@ -147,17 +206,73 @@ public:
      */
     void print() const;
 
+    /**
+     * Writes the CFG to a json file in the input format, productions with a probability get a "prob" field
+     * @param filename json file that is written
+     */
+    void save(const std::string &filename) const;
+
     /**
      * Function that runs the CYK algorithm
      * @param input_string string that has to be checked
+     * @param print if true, the CYK table and the result are printed
+     * @return true if the CFG accepts the string else false
+     */
+    bool accepts(const std::string &input_string, bool print = true);
+
+    /**
+     * Checks if the CFG accepts a string without printing anything.
+     * The first call picks the cheapest correct engine (DFA, LL(1), bitset CYK or Earley), later calls reuse it.
+     * Results are looked up in the membership cache first, so a repeated input costs a hash lookup.
+     * @param input_string string that has to be checked
+     * @return true if the CFG accepts the string else false
+     */
+    bool recognize(const std::string &input_string);
+
+    /**
+     * @return the membership engine of the CFG, built on the first call (by one thread, the others wait for it)
+     */
+    const Recognizer &getRecognizer();
+
+    /**
+     * Replaces the membership cache, the same cache can be shared by several CFGs (and threads).
+     * Without a call, recognize creates a cache of the default capacity the first time it is called.
+     * @param membership_cache the new cache, null to stop caching
+     */
+    void setCache(std::shared_ptr<MembershipCache> membership_cache);
+
+    /**
+     * @return the membership cache, null if caching is off or recognize was not called yet
      */
-    void accepts(const std::string &input_string);
+    [[nodiscard]] std::shared_ptr<MembershipCache> getCache() const;
+
+    /**
+     * Checks if the CFG is regular (right-linear or left-linear)
+     * @return true if the CFG is regular else false
+     */
+    [[nodiscard]] bool isRegular() const;
 
     /**
      * LL(1) parser implementation
      */
     void ll();
 
+    /**
+     * Builds the LL(1) parse table without printing it
+     * @return the parse table with the FIRST and FOLLOW sets
+     */
+    ParseTable buildParseTable();
+
+    /**
+     * Makes the CFG LL(1)-parseable where possible: removes (direct and indirect) left recursion,
+     * left factors the bodies and then runs the LL(1) construction again.
+     * The transformation runs on a copy, the CFG is only replaced if the result is LL(1); the probabilities
+     * of the old productions are then dropped and the new LL(1) table is printed. Otherwise the CFG is left
+     * unchanged and nothing is printed.
+     * @return true if the resulting LL(1) table has no conflicts (and the CFG was replaced) else false
+     */
+    bool makeLL1();
+
     /**
      * Adds a variable to the set of variables
      * @param variable the variable to add
@@ -183,8 +298,53 @@ public:
      */
     void addProductionRule(std::string head, std::string body);
 
+    /**
+     * Adds a weighted production rule to the productions
+     * @param head the head of the production
+     * @param body the body of the production
+     * @param probability the probability of the production, between 0 and 1
+     */
+    void addProductionRule(const std::string &head, const std::string &body, double probability);
+
+    /**
+     * @param head the head of the production
+     * @param body the body of the production
+     * @return the probability of the production, 1 if it has none
+     */
+    [[nodiscard]] double getProbability(const std::string &head, const std::string &body) const;
+
+    /**
+     * Converts the CFG to a PDA with a single state that accepts by empty stack.
+     * A variable on top of the stack is expanded to one of its bodies, a terminal on top is matched with the input.
+     * @param left_factored if true, the bodies of a head that start with the same terminals share their matching
+     * moves, so the PDA only branches where the bodies differ
+     * @return a PDA that is equivalent to the CFG
+     */
+    [[nodiscard]] PDA toPDA(bool left_factored = false) const;
+
+    [[nodiscard]] const StringSet &getVariables() const;
+
+    [[nodiscard]] const StringSet &getTerminals() const;
+
+    [[nodiscard]] const std::map<std::string, StringSet> &getProductionRules() const;
+
+    [[nodiscard]] const std::map<std::string, std::map<std::string, double>> &getProbabilities() const;
+
+    [[nodiscard]] const std::string &getStartSymbol() const;
+
 private:
 
+    /**
+     * Drops the cached recognizers, called whenever the CFG changes
+     */
+    void invalidate();
+
+    /**
+     * Builds the recognizer (and the cache) if there is none yet, safe to call from several threads
+     * @return the recognizer
+     */
+    std::shared_ptr<Recognizer> loadRecognizer();
+
     /**
      * Function that checks if a symbol is a terminal of the CFG
      * @param symbol the symbol to verify
@@ -211,6 +371,12 @@ private:
     StringSet calculateFollow(const std::string &variable, std::map<std::string, StringSet> &firstSet,
                               std::map<std::string, StringSet> &followSet);
 
+    /**
+     * Prints the FIRST and FOLLOW sets and the LL(1) parse table
+     * @param table a ParseTable built by buildParseTable
+     */
+    void printParseTable(ParseTable &table) const;
+
 };
 
 
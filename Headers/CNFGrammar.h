@@ -0,0 +1,139 @@
+/**
+ * @brief: This file contains the declaration of the CNFGrammar struct, the integer form of a CFG in Chomsky normal form
+ * @author: Emir Murat
+ * @date: 18/10/2026
+ */
+
+#ifndef CFG_CNFGRAMMAR_H
+#define CFG_CNFGRAMMAR_H
+
+#include <cstdint>
+
+#include "IndexedGrammar.h"
+
+/**
+ * A set of variables stored as a bitset of 64-bit words
+ */
+using VariableSet = std::vector<std::uint64_t>;
+
+/**
+ * A binary production head -> left right
+ */
+struct BinaryRule {
+    int head;
+    int left;
+    int right;
+    /**
+     * The production id in the IndexedGrammar
+     */
+    int production;
+};
+
+/**
+ * A terminal production head -> terminal
+ */
+struct TerminalRule {
+    int head;
+    /**
+     * The production id in the IndexedGrammar
+     */
+    int production;
+};
+
+/**
+ * Integer form of a CFG in Chomsky normal form that is shared by the CYK based recognizers.
+ * Every body is a single terminal or two variables, only the start symbol may have an epsilon body.
+ */
+struct CNFGrammar {
+
+    IndexedGrammar grammar;
+
+    int variable_count = 0;
+
+    int terminal_count = 0;
+
+    int start = -1;
+
+    /**
+     * Number of 64-bit words in a VariableSet
+     */
+    int words = 0;
+
+    /**
+     * True if the start symbol has an epsilon body
+     */
+    bool accepts_empty = false;
+
+    std::vector<BinaryRule> binary_rules;
+
+    /**
+     * The terminal productions of every terminal (indexed by terminal - variable_count)
+     */
+    std::vector<std::vector<TerminalRule>> terminal_rules;
+
+    /**
+     * The indices of the binary rules of every left variable
+     */
+    std::vector<std::vector<int>> rules_by_left;
+
+    /**
+     * The indices of the binary rules of every head
+     */
+    std::vector<std::vector<int>> rules_by_head;
+
+    /**
+     * Checks if a grammar is in Chomsky normal form
+     * @param grammar an indexed grammar
+     * @return true if every body is a single terminal or two variables (and only the start symbol is nullable)
+     */
+    static bool isCNF(const IndexedGrammar &grammar);
+
+    /**
+     * @param cfg a CFG in Chomsky normal form
+     * @throws std::runtime_error if the CFG is not in Chomsky normal form
+     */
+    explicit CNFGrammar(const CFG &cfg);
+
+    /**
+     * Converts an input string to terminal indices (terminal - variable_count), every character is one terminal
+     * @param input the input string
+     * @return the terminal indices, -1 for characters that are not a terminal
+     */
+    [[nodiscard]] std::vector<int> tokenize(const std::string &input) const;
+
+    /**
+     * @return an empty VariableSet
+     */
+    [[nodiscard]] VariableSet emptySet() const {
+        return VariableSet(words, 0);
+    }
+
+};
+
+/**
+ * Bit operations on raw VariableSet words
+ */
+inline bool testBit(const std::uint64_t *set, int bit) {
+    return (set[bit >> 6] >> (bit & 63)) & 1;
+}
+
+inline void setBit(std::uint64_t *set, int bit) {
+    set[bit >> 6] |= std::uint64_t{1} << (bit & 63);
+}
+
+/**
+ * Calls function for every bit that is set in a VariableSet of the given number of words
+ */
+template<class Function>
+inline void forEachBit(const std::uint64_t *set, int words, Function function) {
+    for (int w = 0; w < words; w++) {
+        std::uint64_t word = set[w];
+        while (word) {
+            function(w * 64 + __builtin_ctzll(word));
+            word &= word - 1;
+        }
+    }
+}
+
+
+#endif //CFG_CNFGRAMMAR_H
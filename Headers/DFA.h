@@ -0,0 +1,83 @@
+/**
+ * @brief: This file contains the declaration of the DFA class, a table-driven automaton for regular CFGs
+ * @author: Emir Murat
+ * @date: 18/10/2026
+ */
+
+#ifndef CFG_DFA_H
+#define CFG_DFA_H
+
+#include "IndexedGrammar.h"
+
+class DFA {
+
+private:
+
+    int state_count = 0;
+
+    int column_count = 0;
+
+    int start = -1;
+
+    /**
+     * Flat transition table indexed by state * column_count + column, -1 if the input is rejected
+     */
+    std::vector<int> table;
+
+    std::vector<bool> accepting;
+
+    /**
+     * Maps a single character to its column, -1 if the character is not a terminal
+     */
+    std::array<int, 256> char_columns{};
+
+public:
+
+    /**
+     * The kind of linearity of a grammar
+     */
+    enum class Linearity {
+        None,
+        Right,
+        Left
+    };
+
+    /**
+     * Checks if a grammar is regular: every body has at most one variable, and either all variables
+     * are at the end of their body (right-linear) or all at the start (left-linear)
+     * @param grammar an indexed grammar
+     * @return the linearity of the grammar, Linearity::None if it is not regular
+     */
+    static Linearity linearity(const IndexedGrammar &grammar);
+
+    /**
+     * Compiles a regular CFG: builds an NFA, runs the subset construction and minimizes the result (Hopcroft)
+     * @param cfg a right-linear or left-linear CFG
+     * @param max_states the maximum number of subsets the construction may create, 0 for no limit
+     * @throws std::runtime_error if the CFG is not regular or the subset construction exceeds max_states
+     */
+    explicit DFA(const CFG &cfg, std::size_t max_states = 0);
+
+    /**
+     * Scans a string where every character is a terminal
+     * @param input the input string
+     * @return true if the input is accepted else false
+     */
+    [[nodiscard]] bool accepts(const std::string &input) const;
+
+    /**
+     * @return the number of states of the minimal DFA (without the dead state)
+     */
+    [[nodiscard]] int size() const;
+
+private:
+
+    /**
+     * Minimizes the DFA with Hopcroft's partition refinement
+     */
+    void minimize();
+
+};
+
+
+#endif //CFG_DFA_H
@@ -0,0 +1,107 @@
+/**
+ * @brief: This file contains the declaration of the DPDA class, a compiled runner for deterministic PDAs
+ * @author: Emir Murat
+ * @date: 18/10/2026
+ */
+
+#ifndef CFG_DPDA_H
+#define CFG_DPDA_H
+
+#include <array>
+#include <cstdint>
+
+#include "PDA.h"
+
+class DPDA {
+
+private:
+
+    /**
+     * A compiled move: the next state and the symbols that are pushed (stored bottom to top)
+     */
+    struct Move {
+        int next_state;
+        int push_offset;
+        int push_length;
+    };
+
+    int state_count = 0;
+
+    /**
+     * Number of input columns, column 0 is the epsilon move
+     */
+    int input_count = 1;
+
+    int symbol_count = 0;
+
+    int start_state = 0;
+
+    int start_symbol = 0;
+
+    /**
+     * Flat transition table indexed by (state * input_count + input) * symbol_count + stacktop, -1 if there is no move
+     */
+    std::vector<int> table;
+
+    /**
+     * True if the (state, stacktop) pair has an epsilon move
+     */
+    std::vector<bool> epsilon;
+
+    std::vector<Move> moves;
+
+    /**
+     * The stack symbols pushed by all moves, referenced by push_offset
+     */
+    std::vector<int> push_symbols;
+
+    /**
+     * Maps a single character to its input column, -1 if the character is not an input symbol
+     */
+    std::array<int, 256> char_columns{};
+
+    /**
+     * Maps an input symbol to its input column
+     */
+    std::map<std::string, int> input_columns;
+
+    /**
+     * Maximum height of the stack
+     */
+    std::size_t stack_capacity;
+
+public:
+
+    /**
+     * Compiles a deterministic PDA, the automaton accepts by empty stack (like PDA::toCFG)
+     * @param pda the PDA to compile, it has to be deterministic
+     * @param stack_capacity the size of the stack buffer that is used while running
+     */
+    explicit DPDA(const PDA &pda, std::size_t stack_capacity = 4096);
+
+    /**
+     * Runs the DPDA on a string where every character is an input symbol
+     * @param input the input string
+     * @return true if the input is accepted else false
+     */
+    [[nodiscard]] bool accepts(const std::string &input) const;
+
+    /**
+     * Runs the DPDA on a sequence of input symbols
+     * @param input the input symbols
+     * @return true if the input is accepted else false
+     */
+    [[nodiscard]] bool accepts(const std::vector<std::string> &input) const;
+
+private:
+
+    /**
+     * The linear acceptance loop over input columns
+     * @param columns the input columns, a negative column is an unknown symbol
+     */
+    [[nodiscard]] bool run(const std::vector<int> &columns) const;
+
+};
+
+
+#endif //CFG_DPDA_H
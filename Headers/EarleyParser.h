@@ -0,0 +1,47 @@
+/**
+ * @brief: This file contains the declaration of the EarleyParser class, a recognizer for arbitrary CFGs
+ * @author: Emir Murat
+ * @date: 18/10/2026
+ */
+
+#ifndef CFG_EARLEYPARSER_H
+#define CFG_EARLEYPARSER_H
+
+#include "IndexedGrammar.h"
+
+class EarleyParser {
+
+private:
+
+    IndexedGrammar grammar;
+
+    /**
+     * For every symbol, true if it can derive the empty string
+     */
+    std::vector<bool> nullable;
+
+    /**
+     * Index of the first dotted item (production, 0) of every production, the dotted items of
+     * production p are numbered item_offsets[p] .. item_offsets[p] + |body|
+     */
+    std::vector<std::size_t> item_offsets;
+
+public:
+
+    /**
+     * @param cfg any CFG
+     */
+    explicit EarleyParser(const CFG &cfg);
+
+    /**
+     * Runs the Earley recognizer, nullable variables are skipped while predicting (Aycock and Horspool)
+     * so epsilon productions need no special completion step
+     * @param input the input string, every character is a terminal
+     * @return true if the input is accepted else false
+     */
+    [[nodiscard]] bool accepts(const std::string &input) const;
+
+};
+
+
+#endif //CFG_EARLEYPARSER_H
@@ -0,0 +1,92 @@
+/**
+ * @brief: This file contains the declaration of the ErrorCorrectingCYK class, which finds the string of the language
+ * that is closest to an input in edit distance
+ * @author: Emir Murat
+ * @date: 18/10/2026
+ */
+
+#ifndef CFG_ERRORCORRECTINGCYK_H
+#define CFG_ERRORCORRECTINGCYK_H
+
+#include <limits>
+
+#include "CNFGrammar.h"
+
+/**
+ * The cost of every edit operation on the input, all costs have to be positive
+ */
+struct EditCosts {
+    double insertion = 1.0;
+    double deletion = 1.0;
+    double substitution = 1.0;
+};
+
+/**
+ * Costs and per-cell pruning of the error-correcting chart, the defaults disable the pruning
+ */
+struct CorrectionOptions {
+    EditCosts costs;
+    /**
+     * Drop every derivation of a span that costs more than max_cost
+     */
+    double max_cost = std::numeric_limits<double>::infinity();
+    /**
+     * Drop the variables of a cell that cost more than beam plus the cheapest one of that cell
+     */
+    double beam = std::numeric_limits<double>::infinity();
+};
+
+/**
+ * The result of an error-correcting parse
+ */
+struct Correction {
+    bool found = false;
+    /**
+     * Total cost of the cheapest edits that turn the input into a string of the language
+     */
+    double cost = 0.0;
+    /**
+     * The string of the language that these edits produce
+     */
+    std::string nearest;
+};
+
+class ErrorCorrectingCYK {
+
+private:
+
+    CNFGrammar grammar;
+
+    /**
+     * The indices of the binary rules of every right variable
+     */
+    std::vector<std::vector<int>> rules_by_right;
+
+public:
+
+    /**
+     * @param cfg a CFG in Chomsky normal form
+     * @throws std::runtime_error if the CFG is not in Chomsky normal form
+     */
+    explicit ErrorCorrectingCYK(const CFG &cfg);
+
+    /**
+     * Weighted CYK over the edit operations (Aho and Peterson): every cell keeps, per variable, the cheapest cost
+     * to turn its span into a string the variable derives. A variable may also derive an empty part of a span, at
+     * the cost of inserting its shortest string, so the variables of one cell also depend on each other; those
+     * costs are settled per cell with Dijkstra's algorithm. Takes O(n^3 |R| + n^2 |R| log |V|) time. Only the
+     * variables of a cell that survive the pruning are stored, so max_cost and beam also bound the memory.
+     * @param input the input string, characters that are not terminals can only be deleted or substituted
+     * @param options the edit costs, a cost cap and a beam per cell; with pruning the result may not be the cheapest
+     * @return the edit distance to the language and the nearest string, found is false if the language is empty or
+     * every derivation was pruned
+     * @throws std::runtime_error if an edit cost is not positive
+     */
+    [[nodiscard]] Correction correct(const std::string &input, const CorrectionOptions &options = {}) const;
+
+    [[nodiscard]] const CNFGrammar &getGrammar() const;
+
+};
+
+
+#endif //CFG_ERRORCORRECTINGCYK_H
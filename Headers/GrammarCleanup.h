@@ -0,0 +1,89 @@
+/**
+ * @brief: This file contains the declaration of the GrammarCleanup class, which removes useless symbols from a CFG
+ * @author: Emir Murat
+ * @date: 18/10/2026
+ */
+
+#ifndef CFG_GRAMMARCLEANUP_H
+#define CFG_GRAMMARCLEANUP_H
+
+#include "IndexedGrammar.h"
+
+/**
+ * The effect of a cleanup on the size of a CFG
+ */
+struct CleanupReport {
+
+    std::size_t variables_before = 0;
+
+    std::size_t variables_after = 0;
+
+    std::size_t productions_before = 0;
+
+    std::size_t productions_after = 0;
+
+    /**
+     * Number of productions plus the total length of their bodies
+     */
+    std::size_t size_before = 0;
+
+    std::size_t size_after = 0;
+
+    /**
+     * The variables that can derive the empty string
+     */
+    StringSet nullable;
+
+    /**
+     * The variables that were removed because they are not generating or not reachable
+     */
+    StringSet removed;
+};
+
+class GrammarCleanup {
+
+public:
+
+    /**
+     * Computes the nullable variables in O(|G|) time
+     * @param grammar an indexed grammar
+     * @return for every symbol, true if it can derive the empty string
+     */
+    static std::vector<bool> nullable(const IndexedGrammar &grammar);
+
+    /**
+     * Computes the generating variables (that derive at least one terminal string) in O(|G|) time
+     * @param grammar an indexed grammar
+     * @return for every symbol, true if it is generating (terminals always are)
+     */
+    static std::vector<bool> generating(const IndexedGrammar &grammar);
+
+    /**
+     * Computes the symbols that are reachable from the start symbol in O(|G|) time
+     * @param grammar an indexed grammar
+     * @param usable for every production, true if it may be used
+     * @return for every symbol, true if it appears in a sentential form derived from the start symbol
+     */
+    static std::vector<bool> reachable(const IndexedGrammar &grammar, const std::vector<bool> &usable);
+
+    /**
+     * Removes the useless symbols from a CFG: first the variables that are not generating,
+     * then the variables that are not reachable from the start symbol
+     * @param cfg the CFG that is rewritten
+     * @return a report with the size of the CFG before and after the cleanup
+     */
+    static CleanupReport cleanup(CFG &cfg);
+
+private:
+
+    /**
+     * Marks the heads of productions once all symbols in their body are marked, with a counter per production
+     * @param grammar an indexed grammar
+     * @param marked the initially marked symbols, extended in place
+     */
+    static void propagate(const IndexedGrammar &grammar, std::vector<bool> &marked);
+
+};
+
+
+#endif //CFG_GRAMMARCLEANUP_H
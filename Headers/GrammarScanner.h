@@ -0,0 +1,101 @@
+/**
+ * @brief: This file contains the declaration of the GrammarScanner class, which finds every substring of a text
+ * that a variable derives
+ * @author: Emir Murat
+ * @date: 18/10/2026
+ */
+
+#ifndef CFG_GRAMMARSCANNER_H
+#define CFG_GRAMMARSCANNER_H
+
+#include <functional>
+
+#include "SubstringChart.h"
+
+class GrammarScanner {
+
+public:
+
+    /**
+     * Called for every match, in order of end position and for the same end from the shortest to the longest match
+     */
+    using MatchCallback = std::function<void(const Span &)>;
+
+private:
+
+    CNFGrammar grammar;
+
+    int target = -1;
+
+    std::size_t max_length;
+
+    /**
+     * Ring buffer of the last max_length columns of the chart. Column j holds the cells that span input[j - length .. j)
+     * for length 1 .. max_length, cell (j, length) is stored at ((j % max_length) * max_length + length - 1) * words
+     */
+    std::vector<std::uint64_t> columns;
+
+    /**
+     * The lengths of the non-empty cells of the column that is computed
+     */
+    std::vector<std::size_t> filled;
+
+    /**
+     * The number of characters that were fed
+     */
+    std::size_t position = 0;
+
+public:
+
+    /**
+     * @param cfg a CFG in Chomsky normal form
+     * @param variable the variable whose matches are reported
+     * @param max_length the longest match that is searched for
+     * @throws std::runtime_error if the CFG is not in Chomsky normal form, the variable is unknown or max_length is 0
+     */
+    GrammarScanner(const CFG &cfg, const std::string &variable, std::size_t max_length);
+
+    /**
+     * Scans the next characters of the text. Every character adds one column of at most max_length cells,
+     * so the scan takes O(n L^2 |R|) time and O(L^2 |V|) bits for a text of length n and max_length L.
+     * @param chunk the next characters, the positions of the matches continue after the earlier chunks
+     * @param callback receives every match that ends in the chunk
+     */
+    void feed(const std::string &chunk, const MatchCallback &callback);
+
+    /**
+     * Scans a stream chunk by chunk until it ends
+     * @param stream the text
+     * @param callback receives every match
+     * @param chunk_size the number of characters that is read at once
+     */
+    void scan(std::istream &stream, const MatchCallback &callback, std::size_t chunk_size = 1 << 16);
+
+    /**
+     * Scans a whole text from position 0
+     * @param text the text
+     * @return all matches
+     */
+    std::vector<Span> find(const std::string &text);
+
+    /**
+     * Forgets the fed text, the next character is position 0 again
+     */
+    void reset();
+
+    /**
+     * @return the number of characters that were fed since the last reset
+     */
+    [[nodiscard]] std::size_t getPosition() const;
+
+private:
+
+    /**
+     * Computes the column of one character and reports its matches
+     */
+    void step(char symbol, const MatchCallback &callback);
+
+};
+
+
+#endif //CFG_GRAMMARSCANNER_H
@@ -0,0 +1,54 @@
+/**
+ * @brief: This file contains the declaration of the GrammarTransform class, transformations that rewrite a CFG
+ * @author: Emir Murat
+ * @date: 18/10/2026
+ */
+
+#ifndef CFG_GRAMMARTRANSFORM_H
+#define CFG_GRAMMARTRANSFORM_H
+
+#include "IndexedGrammar.h"
+
+class GrammarTransform {
+
+public:
+
+    /**
+     * Checks if a variable can derive a sentential form that starts with itself,
+     * also through a prefix of nullable variables
+     * @param cfg a CFG
+     * @return true if the CFG is left recursive else false
+     */
+    static bool isLeftRecursive(const CFG &cfg);
+
+    /**
+     * Removes direct and indirect left recursion (Paull's algorithm). A direct left recursive variable
+     * A -> A a | b is replaced by A -> b A', A' -> a A' | epsilon.
+     * Left recursion that is hidden behind nullable variables is not removed.
+     * @param cfg a CFG
+     * @return an equivalent CFG without left recursion
+     */
+    static CFG eliminateLeftRecursion(const CFG &cfg);
+
+    /**
+     * Left factors the bodies of every head: the bodies are grouped in a trie and every trie node
+     * where bodies branch gets a new variable, so A -> a b | a c becomes A -> a A', A' -> b | c
+     * @param cfg a CFG
+     * @return an equivalent left factored CFG
+     */
+    static CFG leftFactor(const CFG &cfg);
+
+    /**
+     * Merges variables whose production sets are equal up to renaming of merged variables.
+     * The variables are refined like a DFA partition: starting from a single block, every round splits the blocks
+     * on the (hashed) set of bodies with variables replaced by their block, until a fixed point is reached.
+     * Every round runs in O(|G| log |G|).
+     * @param cfg a CFG
+     * @return an equivalent CFG with one variable per block
+     */
+    static CFG minimize(const CFG &cfg);
+
+};
+
+
+#endif //CFG_GRAMMARTRANSFORM_H
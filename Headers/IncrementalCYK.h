@@ -0,0 +1,78 @@
+/**
+ * @brief: This file contains the declaration of the IncrementalCYK class, a CYK recognizer for input that grows at the end
+ * @author: Emir Murat
+ * @date: 18/10/2026
+ */
+
+#ifndef CFG_INCREMENTALCYK_H
+#define CFG_INCREMENTALCYK_H
+
+#include "CNFGrammar.h"
+
+class IncrementalCYK {
+
+private:
+
+    CNFGrammar grammar;
+
+    /**
+     * The chart in column order: column j holds the cells (i, j) that span input[i .. j) for i < j,
+     * cell (i, j) is stored at (j * (j - 1) / 2 + i) * words
+     */
+    std::vector<std::uint64_t> chart;
+
+    std::string input;
+
+public:
+
+    /**
+     * @param cfg a CFG in Chomsky normal form
+     * @throws std::runtime_error if the CFG is not in Chomsky normal form
+     */
+    explicit IncrementalCYK(const CFG &cfg);
+
+    /**
+     * Appends a symbol and computes only the new column, in O(n^2 |R|)
+     * @param symbol the appended character
+     * @return true if the CFG accepts the input after the append
+     */
+    bool push(char symbol);
+
+    /**
+     * Appends every character of a string
+     * @param symbols the appended characters
+     * @return true if the CFG accepts the input after the appends
+     */
+    bool push(const std::string &symbols);
+
+    /**
+     * Removes the last symbol by dropping the last column
+     * @throws std::runtime_error if the input is empty
+     */
+    void pop();
+
+    /**
+     * Removes all symbols
+     */
+    void clear();
+
+    /**
+     * @return true if the CFG accepts the current input
+     */
+    [[nodiscard]] bool accepts() const;
+
+    [[nodiscard]] const std::string &getInput() const;
+
+    /**
+     * @param start the start of the span
+     * @param end the end of the span (exclusive), start < end <= input size
+     * @return the variables that derive input[start .. end)
+     */
+    [[nodiscard]] const std::uint64_t *cell(std::size_t start, std::size_t end) const;
+
+    [[nodiscard]] const CNFGrammar &getGrammar() const;
+
+};
+
+
+#endif //CFG_INCREMENTALCYK_H
@@ -0,0 +1,85 @@
+/**
+ * @brief: This file contains the declaration of the IndexedGrammar struct, an integer representation of a CFG
+ * @author: Emir Murat
+ * @date: 18/10/2026
+ */
+
+#ifndef CFG_INDEXEDGRAMMAR_H
+#define CFG_INDEXEDGRAMMAR_H
+
+#include <array>
+
+#include "CFG.h"
+
+/**
+ * Integer representation of a CFG that is used by the analysis passes and recognizers.
+ * Every symbol gets an id, the variables come first: ids [0, variable_count) are variables, the others terminals.
+ * A symbol is a variable if it is declared as one, if it has productions or if it is the start symbol.
+ */
+struct IndexedGrammar {
+
+    /**
+     * Names of the symbols, indexed by id
+     */
+    std::vector<std::string> symbols;
+
+    std::map<std::string, int> ids;
+
+    int variable_count = 0;
+
+    int start = -1;
+
+    /**
+     * Head of every production
+     */
+    std::vector<int> heads;
+
+    /**
+     * Body of every production, an empty body is an epsilon production
+     */
+    std::vector<std::vector<int>> bodies;
+
+    /**
+     * Probability of every production, 1 if the CFG gives it none
+     */
+    std::vector<double> probabilities;
+
+    /**
+     * The productions of every variable
+     */
+    std::vector<std::vector<int>> rules;
+
+    /**
+     * Maps a single character to its terminal id, -1 if there is no such terminal
+     */
+    std::array<int, 256> char_terminals{};
+
+    explicit IndexedGrammar(const CFG &cfg);
+
+    [[nodiscard]] bool isVariable(int symbol) const {
+        return symbol < variable_count;
+    }
+
+    /**
+     * Converts an input string to terminal ids, every character is one terminal
+     * @param input the input string
+     * @return the terminal ids, -1 for characters that are not a terminal
+     */
+    [[nodiscard]] std::vector<int> tokenize(const std::string &input) const;
+
+    /**
+     * Converts the body of a production back to the string format of the CFG
+     * @param production the production id
+     * @return the symbols of the body separated by spaces
+     */
+    [[nodiscard]] std::string bodyString(int production) const;
+
+    /**
+     * @return the size of the grammar: the number of productions plus the total length of their bodies
+     */
+    [[nodiscard]] std::size_t size() const;
+
+};
+
+
+#endif //CFG_INDEXEDGRAMMAR_H
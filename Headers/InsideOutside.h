@@ -0,0 +1,101 @@
+/**
+ * @brief: This file contains the declaration of the InsideOutside class, which estimates PCFG probabilities from a corpus
+ * @author: Emir Murat
+ * @date: 18/10/2026
+ */
+
+#ifndef CFG_INSIDEOUTSIDE_H
+#define CFG_INSIDEOUTSIDE_H
+
+#include "SemiringCYK.h"
+
+class InsideOutside {
+
+private:
+
+    CNFGrammar grammar;
+
+    /**
+     * Probability of every production, indexed by production id
+     */
+    std::vector<double> probabilities;
+
+    /**
+     * The number of corpus strings that the grammar does not accept, in the last call to train
+     */
+    std::size_t rejected = 0;
+
+    /**
+     * For every iteration of the last call to train, the number of accepted strings whose inside probability
+     * underflowed to 0 (or is 0 because the probabilities of their rules were trained to 0)
+     */
+    std::vector<std::size_t> underflows;
+
+public:
+
+    /**
+     * The start probabilities are the ones of the CFG (1 if a production has none), normalized per head
+     * @param cfg a CFG in Chomsky normal form
+     * @throws std::runtime_error if the CFG is not in Chomsky normal form
+     */
+    explicit InsideOutside(const CFG &cfg);
+
+    /**
+     * Runs expectation maximization: every iteration computes the expected rule counts of the corpus with the
+     * inside and outside charts and sets every probability to its count divided by the count of its head.
+     * The corpus is split over threads, every thread sums its own counts and the counts are added afterwards.
+     * The rule weights are built once per iteration and shared by the threads.
+     * Strings that the grammar does not accept are skipped (see getRejectedCount), as are strings whose inside
+     * probability is 0 in an iteration (see getUnderflowCounts).
+     * @param corpus the training strings, every character is a terminal
+     * @param iterations the number of EM iterations
+     * @param thread_count the number of worker threads
+     * @return the log likelihood of the corpus before every iteration
+     */
+    std::vector<double> train(const std::vector<std::string> &corpus, unsigned int iterations,
+                              unsigned int thread_count = 1);
+
+    /**
+     * @return the probability of every production, indexed by production id of the IndexedGrammar of the CFG
+     */
+    [[nodiscard]] const std::vector<double> &getProbabilities() const;
+
+    /**
+     * @return the number of corpus strings of the last call to train that the grammar does not accept
+     */
+    [[nodiscard]] std::size_t getRejectedCount() const;
+
+    /**
+     * @return for every iteration of the last call to train, the number of accepted strings that were skipped
+     * because their inside probability was 0
+     */
+    [[nodiscard]] const std::vector<std::size_t> &getUnderflowCounts() const;
+
+    /**
+     * Builds the CFG with the trained probabilities
+     * @return a copy of the CFG where every production has a probability
+     */
+    [[nodiscard]] CFG toCFG() const;
+
+    /**
+     * Writes the CFG with the trained probabilities to a json file in the input format
+     * @param filename json file that is written
+     */
+    void save(const std::string &filename) const;
+
+private:
+
+    /**
+     * Adds the expected rule counts of one string
+     * @param cyk the inside chart builder with the probabilities of the current iteration
+     * @param tokens terminal indices of the string
+     * @param counts expected count of every production, extended in place
+     * @return the log of the inside probability of the string, -infinity if it is 0
+     */
+    double expectedCounts(const SemiringCYK<InsideSemiring> &cyk, const std::vector<int> &tokens,
+                          std::vector<double> &counts) const;
+
+};
+
+
+#endif //CFG_INSIDEOUTSIDE_H
@@ -15,6 +15,9 @@ struct ParseTable;
 class CFG;
 class TableObject;
 class AssociationGroup;
+struct CleanupReport;
+class Recognizer;
+class PreFilter;
 
 class Logger {
 public:
@@ -48,6 +51,24 @@ public:
     */
     static void printProductions(const std::map<std::string, StringSet> &productions);
 
+    /**
+    * Function that prints how much smaller a CFG got by a cleanup
+    * @param report the report of the cleanup
+    */
+    static void printCleanupReport(const CleanupReport &report);
+
+    /**
+    * Function that prints which membership engine was picked for a CFG and why
+    * @param recognizer the recognizer of the CFG
+    */
+    static void printRecognizer(const Recognizer &recognizer);
+
+    /**
+     * Function that prints how often every filter of a pre-filter rejected an input
+     * @param prefilter a PreFilter
+     */
+    static void printPreFilter(const PreFilter &prefilter);
+
     /**
      * Function that prints the parse table in JSON format
      * @param table a ParseTable
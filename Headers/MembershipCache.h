@@ -0,0 +1,108 @@
+/**
+ * @brief: This file contains the declaration of the MembershipCache class, a bounded thread-safe LRU cache of
+ * membership results
+ * @author: Emir Murat
+ * @date: 18/10/2026
+ */
+
+#ifndef CFG_MEMBERSHIPCACHE_H
+#define CFG_MEMBERSHIPCACHE_H
+
+#include <atomic>
+#include <cstdint>
+#include <list>
+#include <mutex>
+#include <optional>
+#include <unordered_map>
+
+#include "CFG.h"
+
+class MembershipCache {
+
+private:
+
+    struct Entry {
+        std::uint64_t key;
+        std::uint64_t fingerprint;
+        std::string input;
+        bool accepted;
+    };
+
+    /**
+     * One independently locked LRU list, the most recently used entry is at the front
+     */
+    struct Shard {
+        std::mutex mutex;
+        std::list<Entry> entries;
+        std::unordered_map<std::uint64_t, std::list<Entry>::iterator> index;
+    };
+
+    std::vector<Shard> shards;
+
+    std::size_t shard_capacity;
+
+    std::atomic<std::size_t> hits{0};
+
+    std::atomic<std::size_t> misses{0};
+
+public:
+
+    /**
+     * @param capacity the maximum number of results, spread evenly over the shards
+     * @param shard_count the number of independently locked shards
+     * @throws std::runtime_error if the capacity or the number of shards is 0
+     */
+    explicit MembershipCache(std::size_t capacity = 4096, std::size_t shard_count = 16);
+
+    /**
+     * Hashes the start symbol, terminals and productions of a CFG (probabilities do not change membership)
+     * @param cfg the CFG
+     * @return a fingerprint that separates the results of different grammars in a shared cache
+     */
+    static std::uint64_t fingerprint(const CFG &cfg);
+
+    /**
+     * Looks up a result and marks it as most recently used
+     * @param fingerprint the fingerprint of the grammar
+     * @param input the input string
+     * @return the cached result, or no value on a miss
+     */
+    std::optional<bool> lookup(std::uint64_t fingerprint, const std::string &input);
+
+    /**
+     * Stores a result, evicting the least recently used result of the shard when it is full
+     * @param fingerprint the fingerprint of the grammar
+     * @param input the input string
+     * @param accepted the membership result
+     */
+    void insert(std::uint64_t fingerprint, const std::string &input, bool accepted);
+
+    /**
+     * Drops all results and resets the counters
+     */
+    void clear();
+
+    /**
+     * @return the number of cached results
+     */
+    [[nodiscard]] std::size_t size();
+
+    [[nodiscard]] std::size_t getCapacity() const;
+
+    [[nodiscard]] std::size_t getHits() const;
+
+    [[nodiscard]] std::size_t getMisses() const;
+
+private:
+
+    /**
+     * Mixes the hash of the input with the fingerprint of the grammar
+     */
+    static std::uint64_t key(std::uint64_t fingerprint, const std::string &input);
+
+    Shard &shard(std::uint64_t key);
+
+};
+
+
+#endif //CFG_MEMBERSHIPCACHE_H
@@ -8,10 +8,159 @@
 #define CFG_PDA_H
 
 #include <tuple>
+#include <cstdint>
+#include <optional>
 
 #include "json.hpp"
 #include "CFG.h"
 
+using Transition = std::tuple<std::string, std::string, std::string>;
+using TransitionTarget = std::pair<std::string, std::vector<std::string>>;
+
+/**
+ * A single move of the PDA: a transition key together with one of its targets
+ */
+using TransitionMove = std::pair<const Transition *, const TransitionTarget *>;
+
+/**
+ * Production rules generated during the PDA to CFG conversion, stored as packed triple ids.
+ * Every production is laid out as: head triple, move index, body length, body triples...
+ */
+using ProductionBuffer = std::vector<std::uint64_t>;
+
+/**
+ * Interns the [q,X,p] variables of the PDA to CFG conversion as packed integers.
+ * The printable name of a triple is only formatted when it is requested.
+ */
+class TripleTable {
+
+private:
+
+    /**
+     * Names of the states, indexed by state id
+     */
+    std::vector<std::string> state_names;
+
+    /**
+     * Names of the stack symbols, indexed by symbol id
+     */
+    std::vector<std::string> symbol_names;
+
+    std::map<std::string, std::uint64_t> state_ids;
+
+    std::map<std::string, std::uint64_t> symbol_ids;
+
+    /**
+     * Cache of formatted triple names, empty strings have not been formatted yet
+     */
+    std::vector<std::string> names;
+
+public:
+
+    TripleTable() = default;
+
+    /**
+     * Adds a state to the table if it is not present yet
+     * @param state the name of the state
+     * @return the id of the state
+     */
+    std::uint64_t addState(const std::string &state);
+
+    /**
+     * Adds a stack symbol to the table if it is not present yet
+     * @param symbol the name of the stack symbol
+     * @return the id of the stack symbol
+     */
+    std::uint64_t addSymbol(const std::string &symbol);
+
+    /**
+     * @param state the name of an interned state
+     * @return the id of the state
+     */
+    [[nodiscard]] std::uint64_t getState(const std::string &state) const;
+
+    /**
+     * @param symbol the name of an interned stack symbol
+     * @return the id of the stack symbol
+     */
+    [[nodiscard]] std::uint64_t getSymbol(const std::string &symbol) const;
+
+    /**
+     * @return the number of interned states
+     */
+    [[nodiscard]] std::size_t stateCount() const {
+        return state_names.size();
+    }
+
+    /**
+     * @return the number of interned stack symbols
+     */
+    [[nodiscard]] std::size_t symbolCount() const {
+        return symbol_names.size();
+    }
+
+    /**
+     * Packs the triple (q, X, p) into a single integer
+     */
+    [[nodiscard]] std::uint64_t pack(std::uint64_t q, std::uint64_t X, std::uint64_t p) const {
+        return (q * symbol_names.size() + X) * state_names.size() + p;
+    }
+
+    /**
+     * Returns the printable name "[q,X,p]" of a packed triple, the name is formatted once and then cached
+     * @param triple a packed triple
+     */
+    const std::string &name(std::uint64_t triple);
+
+};
+
+/**
+ * The size of the CFG that PDA::toCFG would generate
+ */
+struct ConversionEstimate {
+
+    /**
+     * Exact number of variables (|Q|^2 * |Gamma| triples and the start symbol)
+     */
+    std::size_t variables = 0;
+
+    /**
+     * Exact number of production rules
+     */
+    std::size_t productions = 0;
+
+    /**
+     * Exact number of production rules in pruned mode
+     */
+    std::size_t pruned_productions = 0;
+
+    /**
+     * Estimate of the memory used by the CFG in bytes
+     */
+    std::size_t bytes = 0;
+
+    /**
+     * Estimate of the memory used by the CFG in pruned mode in bytes
+     */
+    std::size_t pruned_bytes = 0;
+};
+
+/**
+ * Limits on the size of the CFG generated by PDA::toCFG, a limit of 0 means unlimited
+ */
+struct ConversionBudget {
+
+    std::size_t max_productions = 0;
+
+    std::size_t max_bytes = 0;
+
+    /**
+     * If true, a conversion over budget switches to pruned mode instead of aborting.
+     * Pruned mode skips bodies with a variable [q,X,p] for which (q, X) has no moves, these can never derive a string.
+     */
+    bool prune = false;
+};
+
 class PDA {
 
 private:
@@ -49,7 +198,7 @@ private:
     /**
      * Transition function of the PDA
      */
-    std::map<std::tuple<std::string, std::string, std::string>, std::set<std::pair<std::string, std::vector<std::string>>>> transitions;
+    std::map<Transition, std::set<TransitionTarget>> transitions;
 
 
 public:
@@ -69,7 +218,130 @@ public:
      * Converts a PDA to a CFG
      * @return a CFG that is equivalent to the PDA
      */
-    CFG toCFG();
+    [[nodiscard]] CFG toCFG() const;
+
+    /**
+     * Converts a PDA to a CFG, the transitions are divided over multiple worker threads
+     * @param thread_count the number of worker threads, the result does not depend on it
+     * @return a CFG that is equivalent to the PDA
+     */
+    [[nodiscard]] CFG toCFG(unsigned int thread_count) const;
+
+    /**
+     * Converts a PDA to a CFG, but first checks the size of the result against a budget
+     * @param thread_count the number of worker threads, the result does not depend on it
+     * @param budget the limits on the size of the CFG
+     * @return a CFG that is equivalent to the PDA
+     * @throws std::runtime_error if the CFG (also in pruned mode, if enabled) exceeds the budget
+     */
+    [[nodiscard]] CFG toCFG(unsigned int thread_count, const ConversionBudget &budget) const;
+
+    /**
+     * Computes the size of the CFG that toCFG would generate without generating it
+     * @return the number of variables and productions and an estimate of the memory usage
+     */
+    [[nodiscard]] ConversionEstimate estimateCFGSize() const;
+
+    /**
+     * Checks if the PDA is deterministic: every (state, input, stacktop) has at most one move and
+     * a (state, stacktop) with an epsilon move has no other moves
+     * @return true if the PDA is deterministic else false
+     */
+    [[nodiscard]] bool isDeterministic() const;
+
+    [[nodiscard]] const StringSet &getStates() const;
+
+    [[nodiscard]] const StringSet &getInputAlphabet() const;
+
+    [[nodiscard]] const StringSet &getStackAlphabet() const;
+
+    [[nodiscard]] const std::string &getStartState() const;
+
+    [[nodiscard]] const std::string &getStartSymbol() const;
+
+    [[nodiscard]] const std::map<Transition, std::set<TransitionTarget>> &getTransitions() const;
+
+    /**
+     * Runs the (nondeterministic) PDA on a string where every character is an input symbol.
+     * The PDA accepts by empty stack, like PDA::toCFG. The configurations are searched breadth first per input
+     * position; a configuration is pruned if its stack needs more input than is left (the sum of the minimum number
+     * of input symbols every stack symbol consumes before it is popped) or holds a symbol that can never be popped,
+     * and the stack height is bounded by (n + 1) |Q|^2 |Γ| (k - 1) + 1 for the longest
+     * replacement k, which a shortest accepting run never exceeds. The answer is exact.
+     * @param input the input string
+     * @return true if the input is accepted else false
+     */
+    [[nodiscard]] bool accepts(const std::string &input) const;
+
+    /**
+     * Runs the (nondeterministic) PDA on a sequence of input symbols, see accepts(const std::string &)
+     * @param input the input symbols
+     * @return true if the input is accepted else false
+     */
+    [[nodiscard]] bool accepts(const std::vector<std::string> &input) const;
+
+    /**
+     * Runs the (nondeterministic) PDA on a string where every character is an input symbol, exploring only
+     * configurations with at most max_stack stack symbols, like accepts but with a smaller stack limit of choice.
+     * Nullable pushes can need a stack that is higher than the input is long, so a rejection is only certain if
+     * no configuration was cut off by the limit.
+     * @param input the input string
+     * @param max_stack the maximal stack height that is explored
+     * @return true if the input is accepted, false if it is rejected, no value if the limit was hit before a
+     * configuration accepted (unknown)
+     */
+    [[nodiscard]] std::optional<bool> acceptsWithin(const std::string &input, std::size_t max_stack) const;
+
+    /**
+     * Runs the (nondeterministic) PDA on a sequence of input symbols with a stack limit,
+     * see acceptsWithin(const std::string &, std::size_t)
+     * @param input the input symbols
+     * @param max_stack the maximal stack height that is explored
+     * @return true if accepted, false if rejected, no value if the limit was hit (unknown)
+     */
+    [[nodiscard]] std::optional<bool> acceptsWithin(const std::vector<std::string> &input,
+                                                    std::size_t max_stack) const;
+
+    /**
+     * Adds a state to the set of states
+     * @param state the state to add
+     */
+    void addState(const std::string &state);
+
+    /**
+     * Sets the input alphabet of the PDA
+     * @param alphabet the input symbols
+     */
+    void setInputAlphabet(const StringSet &alphabet);
+
+    /**
+     * Sets the stack alphabet of the PDA
+     * @param alphabet the stack symbols
+     */
+    void setStackAlphabet(const StringSet &alphabet);
+
+    /**
+     * Sets the start state of the PDA
+     * @param state new start state
+     */
+    void setStartState(const std::string &state);
+
+    /**
+     * Sets the start symbol of the stack
+     * @param symbol new start symbol
+     */
+    void setStartSymbol(const std::string &symbol);
+
+    /**
+     * Adds a transition to the transition function
+     * @param from the current state
+     * @param input the input symbol, an empty string is an epsilon move
+     * @param stacktop the symbol on top of the stack
+     * @param to the next state
+     * @param replacement the symbols that replace the stacktop, the first one becomes the new top
+     */
+    void addTransition(const std::string &from, const std::string &input, const std::string &stacktop,
+                       const std::string &to, const std::vector<std::string> &replacement);
 
 
 };
@@ -0,0 +1,107 @@
+/**
+ * @brief: This file contains the declaration of the ParseForest struct and the ForestParser class,
+ * which build a shared packed parse forest (SPPF) of all parse trees of an input
+ * @author: Emir Murat
+ * @date: 18/10/2026
+ */
+
+#ifndef CFG_PARSEFOREST_H
+#define CFG_PARSEFOREST_H
+
+#include "CNFGrammar.h"
+#include "ViterbiParser.h"
+
+/**
+ * A node of the forest. A symbol node (variable or terminal over input[start .. start + length)) has one packed
+ * child per way it can be derived; a packed node is a back pointer (production, split) whose children are
+ * the symbol nodes of the body.
+ */
+struct ForestNode {
+    bool packed;
+    /**
+     * The symbol id of a symbol node, the production id of a packed node
+     */
+    int symbol;
+    int start;
+    int length;
+    /**
+     * Length of the left child of a binary packed node, 0 otherwise
+     */
+    int split;
+    /**
+     * The children are children[first_child .. first_child + child_count)
+     */
+    int first_child;
+    int child_count;
+};
+
+/**
+ * A shared packed parse forest: every (symbol, start, length) exists once (hash-consed) and all nodes live in one arena,
+ * so the forest has polynomial size even when the number of trees is exponential
+ */
+struct ParseForest {
+
+    /**
+     * The arena of nodes
+     */
+    std::vector<ForestNode> nodes;
+
+    std::vector<int> children;
+
+    /**
+     * The symbol node of the start symbol over the whole input, -1 if the input is rejected
+     */
+    int root = -1;
+
+    /**
+     * Names of the symbols, indexed by id
+     */
+    std::vector<std::string> symbols;
+
+    /**
+     * @return the number of parse trees in the forest, saturated at the maximum of std::uint64_t
+     */
+    [[nodiscard]] std::uint64_t countTrees() const;
+
+    /**
+     * Unfolds one tree of the forest
+     * @param index the index of the tree, in [0, countTrees())
+     * @return the tree with that index
+     */
+    [[nodiscard]] ParseTree tree(std::uint64_t index) const;
+
+private:
+
+    /**
+     * @return for every node, the number of trees below it (saturated)
+     */
+    [[nodiscard]] std::vector<std::uint64_t> countAll() const;
+
+};
+
+class ForestParser {
+
+private:
+
+    CNFGrammar grammar;
+
+public:
+
+    /**
+     * @param cfg a CFG in Chomsky normal form
+     * @throws std::runtime_error if the CFG is not in Chomsky normal form
+     */
+    explicit ForestParser(const CFG &cfg);
+
+    /**
+     * Runs CYK with bitset cells and then records the back pointers (split, production) of the cell entries that
+     * are reachable from the root, hash-consing every (symbol, start, length) into one node
+     * @param input the input string, every character is a terminal
+     * @return the forest of all parse trees, root is -1 if the input is rejected
+     */
+    [[nodiscard]] ParseForest parse(const std::string &input) const;
+
+};
+
+
+#endif //CFG_PARSEFOREST_H
@@ -0,0 +1,125 @@
+/**
+ * @brief: This file contains the declaration of the PreFilter class, linear-time checks that reject inputs before
+ * a recognizer runs
+ * @author: Emir Murat
+ * @date: 18/10/2026
+ */
+
+#ifndef CFG_PREFILTER_H
+#define CFG_PREFILTER_H
+
+#include <atomic>
+
+#include "IndexedGrammar.h"
+
+/**
+ * Which filters a PreFilter uses
+ */
+struct PreFilterOptions {
+    bool length = true;
+    bool alphabet = true;
+    bool first = true;
+    bool last = true;
+    bool bigram = true;
+};
+
+class PreFilter {
+
+public:
+
+    /**
+     * The filters, in the order they are tried
+     */
+    enum class Filter {
+        Length,
+        Alphabet,
+        First,
+        Last,
+        Bigram
+    };
+
+    static constexpr int filter_count = 5;
+
+private:
+
+    PreFilterOptions options;
+
+    int terminal_count = 0;
+
+    /**
+     * Shortest and longest length of a string of the language (YieldBounds::infinite if unbounded)
+     */
+    std::size_t min_length = 0;
+
+    std::size_t max_length = 0;
+
+    /**
+     * Maps a single character to the index of its terminal if that terminal occurs in a string of the language, else -1
+     */
+    std::array<int, 256> char_terminals{};
+
+    /**
+     * The terminals that can start and end a non-empty string of the language, indexed by terminal
+     */
+    std::vector<bool> first;
+
+    std::vector<bool> last;
+
+    /**
+     * The adjacent terminal pairs that occur in strings of the language, indexed by left * terminal_count + right
+     */
+    std::vector<bool> bigrams;
+
+    /**
+     * How often every filter rejected an input, and the number of checked inputs
+     */
+    mutable std::array<std::atomic<std::size_t>, filter_count> fired{};
+
+    mutable std::atomic<std::size_t> checked{0};
+
+public:
+
+    /**
+     * Computes the filters of a CFG once, over its useful productions
+     * @param cfg the CFG
+     * @param options the filters that are used
+     */
+    explicit PreFilter(const CFG &cfg, const PreFilterOptions &options = {});
+
+    /**
+     * Checks an input in linear time
+     * @param input the input string, every character is a terminal
+     * @return false if a filter proves that the CFG rejects the input, true if the input has to be recognized
+     */
+    [[nodiscard]] bool check(const std::string &input) const;
+
+    /**
+     * @param filter a filter
+     * @return how often the filter rejected an input
+     */
+    [[nodiscard]] std::size_t getFired(Filter filter) const;
+
+    /**
+     * @return the number of inputs that were checked
+     */
+    [[nodiscard]] std::size_t getChecked() const;
+
+    /**
+     * @return the name of a filter
+     */
+    static std::string filterName(Filter filter);
+
+    void resetCounters();
+
+private:
+
+    /**
+     * Counts a rejection
+     * @return false
+     */
+    bool reject(Filter filter) const;
+
+};
+
+
+#endif //CFG_PREFILTER_H
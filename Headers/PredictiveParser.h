@@ -0,0 +1,70 @@
+/**
+ * @brief: This file contains the declaration of the PredictiveParser class, a table-driven LL(1) recognizer
+ * @author: Emir Murat
+ * @date: 18/10/2026
+ */
+
+#ifndef CFG_PREDICTIVEPARSER_H
+#define CFG_PREDICTIVEPARSER_H
+
+#include "IndexedGrammar.h"
+
+class PredictiveParser {
+
+private:
+
+    int variable_count = 0;
+
+    /**
+     * Number of table columns: the terminals plus the end of the input (the last column)
+     */
+    int column_count = 1;
+
+    int start = -1;
+
+    /**
+     * Flat parse table indexed by variable * column_count + column, -1 if there is no production
+     */
+    std::vector<int> table;
+
+    /**
+     * Body of every production
+     */
+    std::vector<std::vector<int>> bodies;
+
+    /**
+     * Maps a single character to its terminal id, -1 if there is no such terminal
+     */
+    std::array<int, 256> char_terminals{};
+
+    /**
+     * True if a table entry has more than one production
+     */
+    bool conflicts = false;
+
+public:
+
+    /**
+     * Builds the LL(1) parse table, FIRST and FOLLOW are computed as fixed points over bitsets
+     * so left recursion ends up as a conflict instead of an endless recursion
+     * @param grammar an indexed grammar
+     */
+    explicit PredictiveParser(const IndexedGrammar &grammar);
+
+    /**
+     * @return true if the parse table has no conflicts
+     */
+    [[nodiscard]] bool isLL1() const;
+
+    /**
+     * Runs the predictive parser on a string where every character is a terminal
+     * @param input the input string
+     * @return true if the input is accepted else false
+     * @throws std::runtime_error if the grammar is not LL(1)
+     */
+    [[nodiscard]] bool accepts(const std::string &input) const;
+
+};
+
+
+#endif //CFG_PREDICTIVEPARSER_H
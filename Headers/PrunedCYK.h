@@ -0,0 +1,54 @@
+/**
+ * @brief: This file contains the declaration of the PrunedCYK class, a CYK recognizer that skips the rules and
+ * splits that cannot fit a span
+ * @author: Emir Murat
+ * @date: 18/10/2026
+ */
+
+#ifndef CFG_PRUNEDCYK_H
+#define CFG_PRUNEDCYK_H
+
+#include "CNFGrammar.h"
+#include "YieldBounds.h"
+
+class PrunedCYK {
+
+private:
+
+    CNFGrammar grammar;
+
+    YieldBounds bounds;
+
+    /**
+     * True if every binary rule has a child with a finite maximum yield. Otherwise a rule like S -> S S marks
+     * its children at (nearly) every span and the top-down pass is skipped.
+     */
+    bool top_down = false;
+
+public:
+
+    /**
+     * @param cfg a CFG in Chomsky normal form
+     * @throws std::runtime_error if the CFG is not in Chomsky normal form
+     */
+    explicit PrunedCYK(const CFG &cfg);
+
+    /**
+     * Runs CYK in two passes. The top-down pass marks, from the start symbol over the whole input down to the
+     * single characters, the variables that a derivation of the input may use at every span; a rule A -> B C
+     * of a marked A only marks the splits where B and C fit the yield bounds. The bottom-up pass skips the cells
+     * without marked variables, only tries the splits where a rule of a marked head fits the yield bounds and only
+     * sets the marked heads, so the chart stays sparse. If a binary rule has two children with an unbounded
+     * yield (in particular if no variable has a finite maximum yield), the top-down pass is skipped and the
+     * bottom-up pass only filters the splits, so it never does more work than BitsetCYK.
+     * @param input the input string, every character is a terminal
+     * @return true if the input is accepted else false
+     */
+    [[nodiscard]] bool accepts(const std::string &input) const;
+
+    [[nodiscard]] const YieldBounds &getBounds() const;
+
+};
+
+
+#endif //CFG_PRUNEDCYK_H
@@ -0,0 +1,102 @@
+/**
+ * @brief: This file contains the declaration of the Recognizer class, which picks the membership engine of a CFG
+ * @author: Emir Murat
+ * @date: 18/10/2026
+ */
+
+#ifndef CFG_RECOGNIZER_H
+#define CFG_RECOGNIZER_H
+
+#include "CFG.h"
+
+class DFA;
+class PredictiveParser;
+class BitsetCYK;
+class ValiantRecognizer;
+class EarleyParser;
+class PreFilter;
+
+class Recognizer {
+
+public:
+
+    /**
+     * The membership engines, from cheapest to most general
+     */
+    enum class Engine {
+        DFA,
+        LL1,
+        CYK,
+        Earley
+    };
+
+    /**
+     * Upper bound on the number of DFA states before the subset construction is given up
+     */
+    static constexpr std::size_t max_dfa_states = 4096;
+
+    /**
+     * From this input length on, a CNF grammar is recognized with Valiant's algorithm instead of bitset CYK
+     * (the crossover measured by the benchmark)
+     */
+    static constexpr std::size_t valiant_length = 32;
+
+private:
+
+    Engine engine = Engine::Earley;
+
+    /**
+     * Why the engine was picked (and why the cheaper ones were not)
+     */
+    std::string reason;
+
+    std::shared_ptr<DFA> dfa;
+
+    std::shared_ptr<PredictiveParser> predictive;
+
+    std::shared_ptr<BitsetCYK> cyk;
+
+    std::shared_ptr<ValiantRecognizer> valiant;
+
+    std::shared_ptr<EarleyParser> earley;
+
+    /**
+     * Linear-time checks in front of the CYK and Earley engines, null for the DFA and LL(1) engines
+     */
+    std::shared_ptr<PreFilter> prefilter;
+
+public:
+
+    /**
+     * Inspects the CFG once and builds the cheapest engine that is correct for it:
+     * regular -> DFA, LL(1) without conflicts -> predictive parser, Chomsky normal form -> bitset CYK
+     * (Valiant for long inputs), otherwise Earley. The CYK and Earley engines get a PreFilter in front of them.
+     * @param cfg the CFG
+     */
+    explicit Recognizer(const CFG &cfg);
+
+    /**
+     * Checks if the CFG accepts a string with the selected engine
+     * @param input the input string, every character is a terminal
+     * @return true if the input is accepted else false
+     */
+    [[nodiscard]] bool accepts(const std::string &input) const;
+
+    [[nodiscard]] Engine getEngine() const;
+
+    /**
+     * @return the name of the selected engine
+     */
+    [[nodiscard]] std::string getEngineName() const;
+
+    [[nodiscard]] const std::string &getReason() const;
+
+    /**
+     * @return the pre-filter of the engine, null if the engine is already linear
+     */
+    [[nodiscard]] std::shared_ptr<const PreFilter> getPreFilter() const;
+
+};
+
+
+#endif //CFG_RECOGNIZER_H
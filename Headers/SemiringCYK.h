@@ -0,0 +1,235 @@
+/**
+ * @brief: This file contains the SemiringCYK template, a CYK core that is generic over the semiring of its cells
+ * @author: Emir Murat
+ * @date: 18/10/2026
+ */
+
+#ifndef CFG_SEMIRINGCYK_H
+#define CFG_SEMIRINGCYK_H
+
+#include <cmath>
+#include <limits>
+
+#include "CNFGrammar.h"
+
+/**
+ * Recognition: is there a parse tree (stored as a byte, the chart is a std::vector<Value>)
+ */
+struct BooleanSemiring {
+    using Value = std::uint8_t;
+
+    static Value zero() { return 0; }
+
+    static Value one() { return 1; }
+
+    static Value plus(Value a, Value b) { return a | b; }
+
+    static Value times(Value a, Value b) { return a & b; }
+};
+
+/**
+ * The number of parse trees, an overflow throws instead of wrapping around
+ */
+struct CountingSemiring {
+    using Value = std::uint64_t;
+
+    static Value zero() { return 0; }
+
+    static Value one() { return 1; }
+
+    static Value plus(Value a, Value b) {
+        Value result;
+        if (__builtin_add_overflow(a, b, &result)) {
+            throw (std::runtime_error("CountingSemiring error::the number of parse trees overflows"));
+        }
+        return result;
+    }
+
+    static Value times(Value a, Value b) {
+        Value result;
+        if (__builtin_mul_overflow(a, b, &result)) {
+            throw (std::runtime_error("CountingSemiring error::the number of parse trees overflows"));
+        }
+        return result;
+    }
+};
+
+/**
+ * The probability of the best parse tree (max-product)
+ */
+struct ViterbiSemiring {
+    using Value = double;
+
+    static Value zero() { return 0.0; }
+
+    static Value one() { return 1.0; }
+
+    static Value plus(Value a, Value b) { return a < b ? b : a; }
+
+    static Value times(Value a, Value b) { return a * b; }
+};
+
+/**
+ * The summed probability of all parse trees (inside probability)
+ */
+struct InsideSemiring {
+    using Value = double;
+
+    static Value zero() { return 0.0; }
+
+    static Value one() { return 1.0; }
+
+    static Value plus(Value a, Value b) { return a + b; }
+
+    static Value times(Value a, Value b) { return a * b; }
+};
+
+/**
+ * The log of the summed probability of all parse trees (inside probability in log space)
+ */
+struct LogSumExpSemiring {
+    using Value = double;
+
+    static Value zero() { return -std::numeric_limits<double>::infinity(); }
+
+    static Value one() { return 0.0; }
+
+    static Value plus(Value a, Value b) {
+        if (a < b) {
+            std::swap(a, b);
+        }
+        if (b == zero()) {
+            return a;
+        }
+        return a + std::log1p(std::exp(b - a));
+    }
+
+    static Value times(Value a, Value b) { return a + b; }
+};
+
+template<class Semiring>
+class SemiringCYK {
+
+public:
+
+    using Value = typename Semiring::Value;
+
+private:
+
+    CNFGrammar grammar;
+
+    /**
+     * Weight of every binary rule and terminal rule, and of the epsilon production of the start symbol
+     */
+    std::vector<Value> binary_weights;
+
+    std::vector<std::vector<Value>> terminal_weights;
+
+    Value empty_weight = Semiring::zero();
+
+public:
+
+    /**
+     * Every production gets weight one
+     * @param grammar a grammar in Chomsky normal form
+     */
+    explicit SemiringCYK(const CNFGrammar &grammar)
+            : SemiringCYK(grammar, std::vector<Value>(grammar.grammar.heads.size(), Semiring::one())) {
+    }
+
+    /**
+     * @param grammar a grammar in Chomsky normal form
+     * @param weights the weight of every production, indexed by production id of grammar.grammar
+     */
+    SemiringCYK(const CNFGrammar &grammar, const std::vector<Value> &weights) : grammar(grammar) {
+        for (const auto &rule: grammar.binary_rules) {
+            binary_weights.push_back(weights[rule.production]);
+        }
+        terminal_weights.resize(grammar.terminal_count);
+        for (int terminal = 0; terminal < grammar.terminal_count; terminal++) {
+            for (const auto &rule: grammar.terminal_rules[terminal]) {
+                terminal_weights[terminal].push_back(weights[rule.production]);
+            }
+        }
+        for (int production: grammar.grammar.rules[grammar.start]) {
+            if (grammar.grammar.bodies[production].empty()) {
+                empty_weight = Semiring::plus(empty_weight, weights[production]);
+            }
+        }
+    }
+
+    /**
+     * @return the index of the value of variable in cell (i, length) of a chart over n tokens
+     */
+    [[nodiscard]] std::size_t index(std::size_t i, std::size_t length, std::size_t n, int variable) const {
+        return ((length - 1) * n + i) * grammar.variable_count + variable;
+    }
+
+    /**
+     * Fills the flat chart: the value of variable A in cell (i, length) sums, over all parse trees of
+     * A that derive tokens[i .. i + length), the product of their rule weights
+     * @param tokens terminal indices (CNFGrammar::tokenize), none of them negative
+     * @return the chart, indexed by index(i, length, n, A)
+     */
+    [[nodiscard]] std::vector<Value> inside(const std::vector<int> &tokens) const {
+        const std::size_t n = tokens.size();
+        const std::size_t variables = grammar.variable_count;
+        std::vector<Value> chart(n * n * variables, Semiring::zero());
+
+        for (std::size_t i = 0; i < n; i++) {
+            Value *cell = &chart[index(i, 1, n, 0)];
+            const auto &rules = grammar.terminal_rules[tokens[i]];
+            for (std::size_t r = 0; r < rules.size(); r++) {
+                cell[rules[r].head] = Semiring::plus(cell[rules[r].head], terminal_weights[tokens[i]][r]);
+            }
+        }
+        for (std::size_t length = 2; length <= n; length++) {
+            for (std::size_t i = 0; i + length <= n; i++) {
+                Value *target = &chart[index(i, length, n, 0)];
+                for (std::size_t split = 1; split < length; split++) {
+                    const Value *left = &chart[index(i, split, n, 0)];
+                    const Value *right = &chart[index(i + split, length - split, n, 0)];
+                    for (std::size_t variable = 0; variable < variables; variable++) {
+                        if (left[variable] == Semiring::zero()) {
+                            continue;
+                        }
+                        for (int r: grammar.rules_by_left[variable]) {
+                            const auto &rule = grammar.binary_rules[r];
+                            if (right[rule.right] == Semiring::zero()) {
+                                continue;
+                            }
+                            target[rule.head] = Semiring::plus(target[rule.head], Semiring::times(
+                                    binary_weights[r], Semiring::times(left[variable], right[rule.right])));
+                        }
+                    }
+                }
+            }
+        }
+        return chart;
+    }
+
+    /**
+     * @param input the input string, every character is a terminal
+     * @return the value of the start symbol over the whole input, zero if a character is not a terminal
+     */
+    [[nodiscard]] Value value(const std::string &input) const {
+        if (input.empty()) {
+            return empty_weight;
+        }
+        std::vector<int> tokens = grammar.tokenize(input);
+        for (int token: tokens) {
+            if (token < 0) {
+                return Semiring::zero();
+            }
+        }
+        return inside(tokens)[index(0, tokens.size(), tokens.size(), grammar.start)];
+    }
+
+    [[nodiscard]] const CNFGrammar &getGrammar() const {
+        return grammar;
+    }
+
+};
+
+
+#endif //CFG_SEMIRINGCYK_H
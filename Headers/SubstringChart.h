@@ -0,0 +1,91 @@
+/**
+ * @brief: This file contains the declaration of the SubstringChart class, a CYK chart that answers membership
+ * queries for every substring of an input
+ * @author: Emir Murat
+ * @date: 18/10/2026
+ */
+
+#ifndef CFG_SUBSTRINGCHART_H
+#define CFG_SUBSTRINGCHART_H
+
+#include "CNFGrammar.h"
+
+/**
+ * A half-open span input[start .. end)
+ */
+struct Span {
+    std::size_t start;
+    std::size_t end;
+
+    bool operator==(const Span &other) const {
+        return start == other.start && end == other.end;
+    }
+};
+
+class SubstringChart {
+
+private:
+
+    CNFGrammar grammar;
+
+    std::string input;
+
+    /**
+     * The triangular chart in column order, like IncrementalCYK: cell (i, j) spans input[i .. j) for i < j
+     * and is stored at (j * (j - 1) / 2 + i) * words
+     */
+    std::vector<std::uint64_t> chart;
+
+    [[nodiscard]] std::uint64_t *cell(std::size_t start, std::size_t end);
+
+    [[nodiscard]] const std::uint64_t *cell(std::size_t start, std::size_t end) const;
+
+public:
+
+    /**
+     * Builds the full CYK chart of an input once, in O(n^3 |R|) time and n (n + 1) / 2 cells of |V| bits.
+     * Characters that are not terminals are allowed, no span that contains one is derived.
+     * @param cfg a CFG in Chomsky normal form
+     * @param input the input string, every character is a terminal
+     * @throws std::runtime_error if the CFG is not in Chomsky normal form
+     */
+    SubstringChart(const CFG &cfg, std::string input);
+
+    /**
+     * Checks in O(1) if a variable derives input[start .. end), an empty span is only derived by a nullable start symbol
+     * @param variable the variable id
+     * @param start the first position of the span
+     * @param end the position after the span
+     * @throws std::runtime_error if the variable id is not in [0, variable_count) or the span is not inside the input
+     */
+    [[nodiscard]] bool derives(int variable, std::size_t start, std::size_t end) const;
+
+    /**
+     * @param variable the name of a variable
+     * @throws std::runtime_error if the variable is not a variable of the CFG or the span is not inside the input
+     */
+    [[nodiscard]] bool derives(const std::string &variable, std::size_t start, std::size_t end) const;
+
+    /**
+     * Finds the non-empty spans derived by a variable that are not inside another span derived by it, in O(n^2)
+     * @param variable the name of a variable
+     * @return the maximal spans, ordered by start (and so by end)
+     * @throws std::runtime_error if the variable is not a variable of the CFG
+     */
+    [[nodiscard]] std::vector<Span> maximalSpans(const std::string &variable) const;
+
+    /**
+     * @param variable the name of a variable
+     * @return the id of the variable
+     * @throws std::runtime_error if the variable is not a variable of the CFG
+     */
+    [[nodiscard]] int variableId(const std::string &variable) const;
+
+    [[nodiscard]] const std::string &getInput() const;
+
+    [[nodiscard]] const CNFGrammar &getGrammar() const;
+
+};
+
+
+#endif //CFG_SUBSTRINGCHART_H
@@ -0,0 +1,46 @@
+/**
+ * @brief: This file contains the declaration of the TiledCYK class, a cache-blocked CYK recognizer for long inputs
+ * @author: Emir Murat
+ * @date: 18/10/2026
+ */
+
+#ifndef CFG_TILEDCYK_H
+#define CFG_TILEDCYK_H
+
+#include "CNFGrammar.h"
+
+class TiledCYK {
+
+private:
+
+    CNFGrammar grammar;
+
+    /**
+     * Number of cells per side of a tile
+     */
+    std::size_t tile_size;
+
+public:
+
+    /**
+     * @param cfg a CFG in Chomsky normal form
+     * @param tile_size the number of cells per side of a tile
+     * @throws std::runtime_error if the CFG is not in Chomsky normal form
+     */
+    explicit TiledCYK(const CFG &cfg, std::size_t tile_size = 64);
+
+    /**
+     * Runs CYK tile by tile. Cell (i, e) spans input[i .. e] and needs the cells (i, k) of its row and (k + 1, e)
+     * of its column, so every cell is stored twice: in a row-major copy (the row of i is contiguous) and a
+     * column-major copy (the column of e is contiguous), and both split partners are read sequentially.
+     * The tiles are processed by block diagonal; the splits that fall in the tiles between the row and the
+     * column of a tile are added as a tile product first, so three tiles make up the working set.
+     * @param input the input string, every character is a terminal
+     * @return true if the input is accepted else false
+     */
+    [[nodiscard]] bool accepts(const std::string &input) const;
+
+};
+
+
+#endif //CFG_TILEDCYK_H
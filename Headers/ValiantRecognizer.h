@@ -0,0 +1,100 @@
+/**
+ * @brief: This file contains the declaration of the ValiantRecognizer class, a subcubic recognizer that reduces
+ * CYK to boolean matrix multiplication
+ * @author: Emir Murat
+ * @date: 18/10/2026
+ */
+
+#ifndef CFG_VALIANTRECOGNIZER_H
+#define CFG_VALIANTRECOGNIZER_H
+
+#include "CNFGrammar.h"
+
+class ValiantRecognizer {
+
+private:
+
+    /**
+     * Bit matrix of every variable: bit j of row i of variable A is set if A derives input[i .. j).
+     * The size is a power of two that is larger than the input length.
+     */
+    struct Chart {
+        std::size_t size;
+        std::size_t row_words;
+        std::vector<std::uint64_t> bits;
+
+        std::uint64_t *row(int variable, std::size_t i) {
+            return &bits[(variable * size + i) * row_words];
+        }
+    };
+
+    /**
+     * A binary rule head -> left right, grouped by right
+     */
+    struct RuleHead {
+        int head;
+        int left;
+    };
+
+    CNFGrammar grammar;
+
+    /**
+     * The binary rules of every right variable
+     */
+    std::vector<std::vector<RuleHead>> rules_by_right;
+
+public:
+
+    /**
+     * Blocks of at most this size are completed directly, with one word per row
+     */
+    static constexpr std::size_t leaf_size = 64;
+
+    /**
+     * Blocks of at least this size are multiplied with the Method of Four Russians
+     */
+    static constexpr std::size_t four_russians_size = 256;
+
+    /**
+     * @param cfg a CFG in Chomsky normal form
+     * @throws std::runtime_error if the CFG is not in Chomsky normal form
+     */
+    explicit ValiantRecognizer(const CFG &cfg);
+
+    /**
+     * Recognizes with Valiant's reduction to boolean matrix multiplication, in the formulation of Okhotin:
+     * the chart is completed block by block and the contribution of the splits between two blocks is one
+     * product of bit matrices per binary rule. Needs |V| * N^2 bits, N the next power of two above the length.
+     * @param input the input string, every character is a terminal
+     * @return true if the input is accepted else false
+     */
+    [[nodiscard]] bool accepts(const std::string &input) const;
+
+private:
+
+    /**
+     * Computes every cell (i, j) with l <= i < j < m
+     */
+    void compute(Chart &chart, std::size_t l, std::size_t m) const;
+
+    /**
+     * Computes the cells of the block [l, m) x [l2, m2) when the triangles [l, m) and [l2, m2) are done
+     * and the splits in [m, l2) are already added to the block
+     */
+    void complete(Chart &chart, std::size_t l, std::size_t m, std::size_t l2, std::size_t m2) const;
+
+    /**
+     * Completes a block of at most leaf_size, row by row from the bottom
+     */
+    void completeLeaf(Chart &chart, std::size_t l, std::size_t m, std::size_t l2, std::size_t m2) const;
+
+    /**
+     * Adds the splits in [splits, splits + size) to the block [rows, rows + size) x [columns, columns + size):
+     * for every rule A -> B C, A[rows][columns] |= B[rows][splits] * C[splits][columns]
+     */
+    void multiply(Chart &chart, std::size_t rows, std::size_t splits, std::size_t columns, std::size_t size) const;
+
+};
+
+
+#endif //CFG_VALIANTRECOGNIZER_H
@@ -0,0 +1,88 @@
+/**
+ * @brief: This file contains the declaration of the ViterbiParser class, which finds the most probable parse of a PCFG
+ * @author: Emir Murat
+ * @date: 18/10/2026
+ */
+
+#ifndef CFG_VITERBIPARSER_H
+#define CFG_VITERBIPARSER_H
+
+#include <limits>
+
+#include "CNFGrammar.h"
+
+/**
+ * A parse tree, the leaves are terminals
+ */
+struct ParseTree {
+    std::string symbol;
+    std::vector<ParseTree> children;
+
+    /**
+     * @return the tree in bracketed form, e.g. (S (A a) (B b))
+     */
+    [[nodiscard]] std::string toString() const;
+};
+
+/**
+ * The result of a Viterbi parse
+ */
+struct ViterbiParse {
+    bool found = false;
+    /**
+     * Log probability of the best tree, minus infinity if there is none
+     */
+    double log_probability = -std::numeric_limits<double>::infinity();
+    /**
+     * Probability of the best tree
+     */
+    double probability = 0.0;
+    ParseTree tree;
+};
+
+/**
+ * Per-cell pruning of the Viterbi chart, the defaults disable it
+ */
+struct BeamOptions {
+    /**
+     * Keep only the beam best variables of every cell, 0 for no limit
+     */
+    std::size_t beam = 0;
+    /**
+     * Drop the variables of a cell whose probability is below threshold times the best one of that cell, 0 for no limit
+     */
+    double threshold = 0.0;
+};
+
+class ViterbiParser {
+
+private:
+
+    CNFGrammar grammar;
+
+    /**
+     * Log probability of every production, indexed by production id
+     */
+    std::vector<double> log_weights;
+
+public:
+
+    /**
+     * @param cfg a PCFG in Chomsky normal form, productions without a probability get probability 1
+     * @throws std::runtime_error if the CFG is not in Chomsky normal form
+     */
+    explicit ViterbiParser(const CFG &cfg);
+
+    /**
+     * Finds the most probable parse tree with CYK in log space. Every cell keeps a sparse list of its
+     * live variables so pruned variables are never combined again.
+     * @param input the input string, every character is a terminal
+     * @param options beam and threshold pruning per cell, with pruning the result may not be the best tree
+     * @return the best tree and its probability, found is false if there is no (unpruned) parse
+     */
+    [[nodiscard]] ViterbiParse parse(const std::string &input, const BeamOptions &options = {}) const;
+
+};
+
+
+#endif //CFG_VITERBIPARSER_H
@@ -0,0 +1,50 @@
+/**
+ * @brief: This file contains the declaration of the YieldBounds struct, the minimum and maximum length of the
+ * strings that every symbol derives
+ * @author: Emir Murat
+ * @date: 18/10/2026
+ */
+
+#ifndef CFG_YIELDBOUNDS_H
+#define CFG_YIELDBOUNDS_H
+
+#include <limits>
+
+#include "IndexedGrammar.h"
+
+struct YieldBounds {
+
+    /**
+     * The bound of a symbol that derives arbitrarily long strings (max) or no string at all (min)
+     */
+    static constexpr std::size_t infinite = std::numeric_limits<std::size_t>::max();
+
+    /**
+     * Length of the shortest string every symbol derives, infinite if it derives none
+     */
+    std::vector<std::size_t> min;
+
+    /**
+     * Length of the longest string every symbol derives, infinite if it is unbounded
+     */
+    std::vector<std::size_t> max;
+
+    /**
+     * The minimum is a shortest-derivation fixed point over the productions. The maximum is computed per strongly
+     * connected component of the variables, in reverse topological order: a component is unbounded if one of its
+     * productions reaches the component again next to a symbol that derives a non-empty string.
+     * @param grammar an indexed grammar
+     */
+    explicit YieldBounds(const IndexedGrammar &grammar);
+
+    /**
+     * @return true if symbol derives a string of the given length according to the bounds
+     */
+    [[nodiscard]] bool fits(int symbol, std::size_t length) const {
+        return min[symbol] <= length && length <= max[symbol];
+    }
+
+};
+
+
+#endif //CFG_YIELDBOUNDS_H
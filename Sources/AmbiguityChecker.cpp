@@ -0,0 +1,212 @@
+//
+// Created by 2005e on 18/10/2026.
+//
+
+#include <functional>
+#include <thread>
+
+#include "../Headers/AmbiguityChecker.h"
+#include "../Headers/YieldBounds.h"
+
+AmbiguityChecker::AmbiguityChecker(const CFG &cfg) : grammar(cfg) {
+    if (grammar.symbols.size() - grammar.variable_count > 256) {
+        throw (std::runtime_error("AmbiguityChecker error::the CFG has more than 256 terminals"));
+    }
+    const std::vector<std::size_t> min_lengths = YieldBounds(grammar).min;
+    // A variable of a body can take the whole length if the other symbols are nullable (terminals never are)
+    for (const auto &body: grammar.bodies) {
+        std::size_t non_empty = 0;
+        bool whole = false;
+        for (int symbol: body) {
+            if (min_lengths[symbol] != 0) {
+                non_empty++;
+                whole = grammar.isVariable(symbol);
+            }
+        }
+        if (non_empty == 0 ? !body.empty() : non_empty == 1 && whole) {
+            self_dependent = true;
+        }
+    }
+}
+
+AmbiguityChecker::Layer AmbiguityChecker::derive(const Table &table, int variable, std::size_t length,
+                                                 const std::vector<std::size_t> &min_lengths,
+                                                 std::size_t limit) const {
+    Layer layer;
+    for (int production: grammar.rules[variable]) {
+        const auto &body = grammar.bodies[production];
+
+        // rest[k] is the shortest yield of body[k ..], it bounds the length the symbols before k may take
+        std::vector<std::size_t> rest(body.size() + 1, 0);
+        for (std::size_t k = body.size(); k-- > 0;) {
+            bool bounded = min_lengths[body[k]] != YieldBounds::infinite && rest[k + 1] != YieldBounds::infinite;
+            rest[k] = bounded ? rest[k + 1] + min_lengths[body[k]] : YieldBounds::infinite;
+        }
+        if (rest[0] > length || layer.size() > limit) {
+            continue;
+        }
+
+        std::vector<std::size_t> lengths;
+        std::string word;
+        std::function<void(std::size_t, std::size_t, std::uint8_t)> combine = [&](std::size_t k, std::size_t remaining,
+                                                                                   std::uint8_t count) {
+            if (layer.size() > limit) {
+                return;
+            }
+            if (k == body.size()) {
+                if (remaining == 0) {
+                    Derivations &entry = layer[word];
+                    entry.count = static_cast<std::uint8_t>(std::min(2, entry.count + count));
+                    Way way{production, lengths};
+                    if (entry.ways.size() < 2 && std::find(entry.ways.begin(), entry.ways.end(), way) == entry.ways.end()) {
+                        entry.ways.push_back(std::move(way));
+                    }
+                }
+                return;
+            }
+            int symbol = body[k];
+            if (!grammar.isVariable(symbol)) {
+                if (remaining >= rest[k]) {
+                    word.push_back(static_cast<char>(symbol - grammar.variable_count));
+                    lengths.push_back(1);
+                    combine(k + 1, remaining - 1, count);
+                    lengths.pop_back();
+                    word.pop_back();
+                }
+                return;
+            }
+            for (std::size_t part = min_lengths[symbol]; part + rest[k + 1] <= remaining; part++) {
+                lengths.push_back(part);
+                for (const auto &[sub, derivations]: table[part][symbol]) {
+                    word += sub;
+                    combine(k + 1, remaining - part, static_cast<std::uint8_t>(std::min(2, count * derivations.count)));
+                    word.resize(word.size() - sub.size());
+                }
+                lengths.pop_back();
+            }
+        };
+        combine(0, length, 1);
+    }
+    return layer;
+}
+
+AmbiguityReport AmbiguityChecker::check(std::size_t max_length, unsigned int thread_count,
+                                        std::size_t max_entries) const {
+    AmbiguityReport report;
+    const std::size_t variables = grammar.variable_count;
+    if (thread_count == 0) {
+        thread_count = 1;
+    }
+    thread_count = std::min<std::size_t>(thread_count, std::max<std::size_t>(variables, 1));
+    const std::vector<std::size_t> min_lengths = YieldBounds(grammar).min;
+
+    Table table;
+    std::size_t stored = 0;
+    for (std::size_t length = 0; length <= max_length; length++) {
+        table.emplace_back(variables);
+        const std::size_t limit = max_entries > stored ? max_entries - stored : 0;
+
+        // Rounds until the layer is stable: every round recomputes all variables from the previous round,
+        // so the variables of one round are independent. Ways that were found earlier are kept first, which
+        // keeps the first derivation of every string free of cycles. Without a body where a variable can take
+        // the whole length, a layer only reads shorter ones and one round is enough.
+        bool changed = true;
+        while (changed) {
+            std::vector<Layer> fresh(variables);
+            auto work = [&](unsigned int chunk) {
+                std::size_t begin = variables * chunk / thread_count;
+                std::size_t end = variables * (chunk + 1) / thread_count;
+                for (std::size_t variable = begin; variable < end; variable++) {
+                    fresh[variable] = derive(table, static_cast<int>(variable), length, min_lengths, limit);
+                }
+            };
+            if (thread_count == 1) {
+                work(0);
+            } else {
+                std::vector<std::thread> workers;
+                for (unsigned int chunk = 0; chunk < thread_count; chunk++) {
+                    workers.emplace_back(work, chunk);
+                }
+                for (auto &worker: workers) {
+                    worker.join();
+                }
+            }
+
+            // Every round derives a superset of the previous one, so the fresh layers give the size of the length
+            std::size_t size = 0;
+            for (const auto &layer: fresh) {
+                size += layer.size();
+            }
+            if (size > limit) {
+                report.budget_exceeded = true;
+                report.checked_length = length == 0 ? 0 : length - 1;
+                return report;
+            }
+
+            changed = false;
+            for (std::size_t variable = 0; variable < variables; variable++) {
+                Layer &layer = table[length][variable];
+                for (auto &[word, derivations]: fresh[variable]) {
+                    auto it = layer.find(word);
+                    if (it == layer.end()) {
+                        layer.emplace(word, std::move(derivations));
+                        changed = true;
+                        continue;
+                    }
+                    if (it->second.count != derivations.count) {
+                        it->second.count = derivations.count;
+                        changed = true;
+                    }
+                    for (auto &way: derivations.ways) {
+                        auto &ways = it->second.ways;
+                        if (ways.size() < 2 && std::find(ways.begin(), ways.end(), way) == ways.end()) {
+                            ways.push_back(std::move(way));
+                        }
+                    }
+                }
+            }
+            changed = changed && self_dependent;
+        }
+        for (const auto &layer: table[length]) {
+            stored += layer.size();
+        }
+
+        report.checked_length = length;
+        for (const auto &[word, derivations]: table[length][grammar.start]) {
+            if (derivations.count < 2) {
+                continue;
+            }
+            report.ambiguous = true;
+            for (char terminal: word) {
+                report.witness += grammar.symbols[grammar.variable_count + static_cast<unsigned char>(terminal)];
+            }
+            report.first = derivation(table, grammar.start, word, false);
+            report.second = derivation(table, grammar.start, word, true);
+            return report;
+        }
+    }
+    return report;
+}
+
+ParseTree AmbiguityChecker::derivation(const Table &table, int symbol, const std::string &word, bool second) const {
+    ParseTree tree;
+    tree.symbol = grammar.symbols[symbol];
+    if (!grammar.isVariable(symbol)) {
+        return tree;
+    }
+    const Derivations &derivations = table[word.size()][symbol].at(word);
+
+    // The second derivation takes the second way, or else the first way with a second derivation of one part
+    const Way &way = second && derivations.ways.size() > 1 ? derivations.ways[1] : derivations.ways[0];
+    bool differ = second && derivations.ways.size() == 1;
+    const auto &body = grammar.bodies[way.production];
+    std::size_t offset = 0;
+    for (std::size_t k = 0; k < body.size(); k++) {
+        std::string part = word.substr(offset, way.lengths[k]);
+        offset += way.lengths[k];
+        bool ambiguous_part = differ && grammar.isVariable(body[k]) && table[part.size()][body[k]].at(part).count > 1;
+        tree.children.push_back(derivation(table, body[k], part, ambiguous_part));
+        differ = differ && !ambiguous_part;
+    }
+    return tree;
+}
@@ -0,0 +1,74 @@
+//
+// Created by 2005e on 18/10/2026.
+//
+
+#include "../Headers/BatchCYK.h"
+
+BatchCYK::BatchCYK(const CFG &cfg) : cyk(cfg) {
+}
+
+namespace {
+    /**
+     * A trie node: the outgoing edges and the inputs that end here
+     */
+    struct TrieNode {
+        std::vector<std::pair<char, int>> edges;
+        std::vector<std::size_t> inputs;
+    };
+}
+
+std::vector<bool> BatchCYK::accepts(const std::vector<std::string> &inputs) {
+    std::vector<TrieNode> trie(1);
+    for (std::size_t index = 0; index < inputs.size(); index++) {
+        int node = 0;
+        for (char symbol: inputs[index]) {
+            int next = -1;
+            for (const auto &edge: trie[node].edges) {
+                if (edge.first == symbol) {
+                    next = edge.second;
+                    break;
+                }
+            }
+            if (next < 0) {
+                next = static_cast<int>(trie.size());
+                trie[node].edges.emplace_back(symbol, next);
+                trie.emplace_back();
+            }
+            node = next;
+        }
+        trie[node].inputs.push_back(index);
+    }
+
+    std::vector<bool> results(inputs.size(), false);
+    columns = 0;
+    cyk.clear();
+
+    // Depth-first walk, every frame is a node and the index of its next edge
+    std::vector<std::pair<int, std::size_t>> stack{{0, 0}};
+    bool accepted = cyk.accepts();
+    for (std::size_t index: trie[0].inputs) {
+        results[index] = accepted;
+    }
+    while (!stack.empty()) {
+        auto &[node, next_edge] = stack.back();
+        if (next_edge == trie[node].edges.size()) {
+            stack.pop_back();
+            if (!stack.empty()) {
+                cyk.pop();
+            }
+            continue;
+        }
+        auto [symbol, child] = trie[node].edges[next_edge++];
+        accepted = cyk.push(symbol);
+        columns++;
+        for (std::size_t index: trie[child].inputs) {
+            results[index] = accepted;
+        }
+        stack.emplace_back(child, 0);
+    }
+    return results;
+}
+
+std::size_t BatchCYK::getColumnCount() const {
+    return columns;
+}
@@ -0,0 +1,49 @@
+//
+// Created by 2005e on 18/10/2026.
+//
+
+#include "../Headers/BitsetCYK.h"
+
+BitsetCYK::BitsetCYK(const CFG &cfg) : grammar(cfg) {
+}
+
+bool BitsetCYK::accepts(const std::string &input) const {
+    std::size_t n = input.size();
+    if (n == 0) {
+        return grammar.accepts_empty;
+    }
+    std::vector<int> tokens = grammar.tokenize(input);
+    const std::size_t words = grammar.words;
+
+    // Cell (i, length) spans input[i .. i + length) and is stored at ((length - 1) * n + i) * words
+    std::vector<std::uint64_t> chart(n * n * words, 0);
+    auto cell = [&chart, n, words](std::size_t i, std::size_t length) {
+        return &chart[((length - 1) * n + i) * words];
+    };
+
+    for (std::size_t i = 0; i < n; i++) {
+        if (tokens[i] < 0) {
+            return false;
+        }
+        for (const auto &rule: grammar.terminal_rules[tokens[i]]) {
+            setBit(cell(i, 1), rule.head);
+        }
+    }
+    for (std::size_t length = 2; length <= n; length++) {
+        for (std::size_t i = 0; i + length <= n; i++) {
+            std::uint64_t *target = cell(i, length);
+            for (std::size_t split = 1; split < length; split++) {
+                const std::uint64_t *right = cell(i + split, length - split);
+                forEachBit(cell(i, split), grammar.words, [&](int left) {
+                    for (int index: grammar.rules_by_left[left]) {
+                        const auto &rule = grammar.binary_rules[index];
+                        if (testBit(right, rule.right)) {
+                            setBit(target, rule.head);
+                        }
+                    }
+                });
+            }
+        }
+    }
+    return testBit(cell(0, n), grammar.start);
+}
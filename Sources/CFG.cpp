@@ -4,6 +4,11 @@
 
 
 #include "../Headers/CFG.h"
+#include "../Headers/PDA.h"
+#include "../Headers/GrammarTransform.h"
+#include "../Headers/DFA.h"
+#include "../Headers/Recognizer.h"
+#include "../Headers/MembershipCache.h"
 
 
 StringSet findExistingRule(const std::string &terminal, const std::map<std::string, StringSet> &productions) {
@@ -48,8 +53,39 @@ CFG::CFG(std::string filename) {
         for (const std::string symbol: (*it)["body"]) {
             body.empty() ? body += symbol : body += " " + symbol;
         }
-        production_rules[head].insert(body);
+        // Optional probability of a PCFG
+        if (it->find("prob") != it->end()) {
+            addProductionRule(head, body, (*it)["prob"].get<double>());
+        } else {
+            production_rules[head].insert(body);
+        }
+    }
+}
+
+void CFG::save(const std::string &filename) const {
+    json j;
+    j["Variables"] = variables;
+    j["Terminals"] = terminals;
+    j["Productions"] = json::array();
+    for (const auto &rule: production_rules) {
+        for (const auto &body: rule.second) {
+            json production;
+            production["head"] = rule.first;
+            production["body"] = Logger::splitString(body);
+            auto head = probabilities.find(rule.first);
+            if (head != probabilities.end() && head->second.find(body) != head->second.end()) {
+                production["prob"] = head->second.at(body);
+            }
+            j["Productions"].push_back(production);
+        }
+    }
+    j["Start"] = start_symbol;
+
+    std::ofstream output_file(filename);
+    if (!output_file) {
+        throw (std::runtime_error("CFG error::cannot write " + filename));
     }
+    output_file << std::setw(2) << j << std::endl;
 }
 
 void CFG::print() const {
@@ -61,18 +97,166 @@ void CFG::print() const {
 
 void CFG::addVariable(const std::string &variable) {
     variables.insert(variable);
+    invalidate();
 }
 
 void CFG::setTerminals(const StringSet &terminal_list) {
     CFG::terminals = terminal_list;
+    invalidate();
 }
 
 void CFG::setStartSymbol(const std::string &startSymbol) {
     start_symbol = startSymbol;
+    invalidate();
+}
+
+const StringSet &CFG::getVariables() const {
+    return variables;
 }
 
-void CFG::addProductionRule(const std::string head, const std::string body) {
+const StringSet &CFG::getTerminals() const {
+    return terminals;
+}
+
+const std::map<std::string, StringSet> &CFG::getProductionRules() const {
+    return production_rules;
+}
+
+const std::map<std::string, std::map<std::string, double>> &CFG::getProbabilities() const {
+    return probabilities;
+}
+
+const std::string &CFG::getStartSymbol() const {
+    return start_symbol;
+}
+
+void CFG::addProductionRule(std::string head, std::string body) {
+    production_rules[head].insert(std::move(body));
+    invalidate();
+}
+
+void CFG::addProductionRule(const std::string &head, const std::string &body, double probability) {
+    if (!(probability >= 0.0 && probability <= 1.0)) {
+        throw (std::runtime_error("CFG error::the probability of " + head + " -> " + body + " is not in [0, 1]"));
+    }
     production_rules[head].insert(body);
+    probabilities[head][body] = probability;
+    invalidate();
+}
+
+double CFG::getProbability(const std::string &head, const std::string &body) const {
+    auto rule = probabilities.find(head);
+    if (rule != probabilities.end()) {
+        auto it = rule->second.find(body);
+        if (it != rule->second.end()) {
+            return it->second;
+        }
+    }
+    return 1.0;
+}
+
+/**
+ * Node of the trie that groups the bodies of one head on their leading terminals
+ */
+struct PrefixNode {
+    std::map<std::string, PrefixNode> children;
+    // The remainders (starting at the first variable) of the bodies that end their terminal prefix here
+    std::vector<std::vector<std::string>> endings;
+};
+
+/**
+ * Recursive helper function for toPDA that adds the moves of a trie node
+ * @param pda the PDA that is being constructed
+ * @param head the head of the productions in the trie
+ * @param node the current trie node
+ * @param symbol the stack symbol that represents the node
+ * @param path the terminals on the path to the node
+ * @param stack_alphabet the stack alphabet, extended with the symbols of the trie nodes
+ */
+void addPrefixMoves(PDA &pda, const std::string &head, const PrefixNode &node, const std::string &symbol,
+                    const std::string &path, StringSet &stack_alphabet) {
+    for (const auto &ending: node.endings) {
+        pda.addTransition("q", "", symbol, "q", ending);
+    }
+    for (const auto &child: node.children) {
+        if (child.second.children.empty() && child.second.endings.size() == 1) {
+            // Only one body continues here, so its remainder can be pushed immediately
+            pda.addTransition("q", child.first, symbol, "q", child.second.endings.front());
+            continue;
+        }
+        std::string child_path = path.empty() ? child.first : path + "." + child.first;
+        std::string child_symbol = "<" + head + "|" + child_path + ">";
+        stack_alphabet.insert(child_symbol);
+        pda.addTransition("q", child.first, symbol, "q", {child_symbol});
+        addPrefixMoves(pda, head, child.second, child_symbol, child_path, stack_alphabet);
+    }
+}
+
+PDA CFG::toPDA(bool left_factored) const {
+
+    PDA pda;
+    pda.addState("q");
+    pda.setStartState("q");
+    pda.setStartSymbol(start_symbol);
+
+    // A symbol is a variable if it is declared as one or if it has productions, other symbols are terminals
+    auto isVariable = [this](const std::string &symbol) {
+        return variables.find(symbol) != variables.end() || production_rules.find(symbol) != production_rules.end();
+    };
+
+    StringSet input_alphabet = terminals;
+    StringSet stack_alphabet = variables;
+    stack_alphabet.insert(start_symbol);
+    for (const auto &rule: production_rules) {
+        stack_alphabet.insert(rule.first);
+        for (const auto &body: rule.second) {
+            for (const auto &symbol: Logger::splitString(body)) {
+                if (!symbol.empty() && !isVariable(symbol)) {
+                    input_alphabet.insert(symbol);
+                }
+            }
+        }
+    }
+    stack_alphabet.insert(input_alphabet.begin(), input_alphabet.end());
+
+    // Terminals on top of the stack are matched with the input
+    for (const auto &terminal: input_alphabet) {
+        pda.addTransition("q", terminal, terminal, "q", {});
+    }
+
+    for (const auto &rule: production_rules) {
+        PrefixNode root;
+        for (const auto &body: rule.second) {
+            std::vector<std::string> symbols;
+            std::istringstream iss(body);
+            std::string symbol;
+            while (iss >> symbol) {
+                symbols.push_back(symbol);
+            }
+            if (!left_factored) {
+                pda.addTransition("q", "", rule.first, "q", symbols);
+                continue;
+            }
+            PrefixNode *node = &root;
+            std::size_t i = 0;
+            while (i < symbols.size() && !isVariable(symbols[i])) {
+                node = &node->children[symbols[i]];
+                i++;
+            }
+            node->endings.emplace_back(symbols.begin() + static_cast<long>(i), symbols.end());
+        }
+        if (left_factored) {
+            addPrefixMoves(pda, rule.first, root, rule.first, "", stack_alphabet);
+        }
+    }
+
+    pda.setInputAlphabet(input_alphabet);
+    pda.setStackAlphabet(stack_alphabet);
+    return pda;
+}
+
+void CFG::invalidate() {
+    std::atomic_store(&recognizer, std::shared_ptr<Recognizer>());
 }
 
 bool CFG::isTerminal(const std::string &symbol) {
@@ -175,7 +359,16 @@ StringSet CFG::calculateFollow(const std::string &variable, std::map<std::string
 }
 
 
-void CFG::accepts(const std::string &input_string) {
+bool CFG::accepts(const std::string &input_string, bool print) {
+
+    if (input_string.empty()) {
+        auto rule = production_rules.find(start_symbol);
+        bool accepted = rule != production_rules.end() && rule->second.find("") != rule->second.end();
+        if (print) {
+            std::cout << std::boolalpha << accepted << std::endl;
+        }
+        return accepted;
+    }
 
     std::vector<std::vector<TableObject>> table;
     AssociationGroup group;
@@ -216,20 +409,75 @@ void CFG::accepts(const std::string &input_string) {
         }
     }
 
-    // Print the table
-    Logger::printAcceptanceTable(table);
+    bool accepted = table[input_string.size() - 1][0].getVariables().find(start_symbol) !=
+                    table[input_string.size() - 1][0].getVariables().end();
+    if (print) {
+        // Print the table
+        Logger::printAcceptanceTable(table);
+
+        // Print the acceptance boolean
+        std::cout << std::boolalpha;
+        std::cout << accepted << std::endl;
+    }
+    return accepted;
+}
+
+bool CFG::recognize(const std::string &input_string) {
+    std::shared_ptr<Recognizer> engine = loadRecognizer();
+    if (!cache) {
+        return engine->accepts(input_string);
+    }
+    if (auto cached = cache->lookup(fingerprint, input_string)) {
+        return *cached;
+    }
+    bool accepted = engine->accepts(input_string);
+    cache->insert(fingerprint, input_string, accepted);
+    return accepted;
+}
+
+const Recognizer &CFG::getRecognizer() {
+    return *loadRecognizer();
+}
 
-    // Print the acceptance boolean
-    std::cout << std::boolalpha;
-    std::cout << (table[input_string.size() - 1][0].getVariables().find(start_symbol) !=
-                  table[input_string.size() - 1][0].getVariables().end()) << std::endl;
+std::shared_ptr<Recognizer> CFG::loadRecognizer() {
+    std::shared_ptr<Recognizer> engine = std::atomic_load(&recognizer);
+    if (engine) {
+        return engine;
+    }
+    std::lock_guard<std::mutex> lock(recognizer_mutex.mutex);
+    engine = std::atomic_load(&recognizer);
+    if (!engine) {
+        // The fingerprint and the cache are written before the recognizer is published
+        engine = std::make_shared<Recognizer>(*this);
+        fingerprint = MembershipCache::fingerprint(*this);
+        if (caching && !cache) {
+            cache = std::make_shared<MembershipCache>();
+        }
+        std::atomic_store(&recognizer, engine);
+    }
+    return engine;
+}
 
+void CFG::setCache(std::shared_ptr<MembershipCache> membership_cache) {
+    caching = membership_cache != nullptr;
+    cache = std::move(membership_cache);
+}
+
+std::shared_ptr<MembershipCache> CFG::getCache() const {
+    return cache;
+}
+
+bool CFG::isRegular() const {
+    return DFA::linearity(IndexedGrammar(*this)) != DFA::Linearity::None;
 }
 
 
 void CFG::ll() {
+    ParseTable table = buildParseTable();
+    printParseTable(table);
+}
 
-    std::cout << ">>> Building LL(1) Table" << std::endl;
+ParseTable CFG::buildParseTable() {
 
 //     FIRST en FOLLOW sets
     std::map<std::string, StringSet> first_set;
@@ -240,19 +488,55 @@ void CFG::ll() {
     new_symbols.insert("<EOS>");
     ParseTable table{variables, new_symbols};
 
-    std::cout << " >> FIRST:" << std::endl;
     for (const auto &variable: variables) {
         first_set[variable] = calculateFirst(variable, {}, table);
-        std::cout << "    " + variable + ": " + Logger::setToString(first_set[variable]) << std::endl;
     }
     table.setFirstSet(first_set);
 
-    std::cout << " >> FOLLOW:" << std::endl;
     for (const auto &variable: variables) {
         follow_set[variable] = calculateFollow(variable, first_set, follow_set);
-        std::cout << "    " + variable + ": " + Logger::setToString(follow_set[variable]) << std::endl;
     }
     table.setFollowSet(follow_set);
+    return table;
+}
+
+bool CFG::makeLL1() {
+    // Transform a copy, the CFG only changes if the result is LL(1)
+    CFG transformed = GrammarTransform::isLeftRecursive(*this) ? GrammarTransform::eliminateLeftRecursion(*this)
+                                                               : *this;
+    transformed = GrammarTransform::leftFactor(transformed);
+    if (GrammarTransform::isLeftRecursive(transformed)) {
+        return false;
+    }
+    ParseTable table = transformed.buildParseTable();
+    if (table.conflicts) {
+        return false;
+    }
+
+    // The cache of this CFG is kept, the probabilities belonged to the old productions
+    variables = std::move(transformed.variables);
+    terminals = std::move(transformed.terminals);
+    production_rules = std::move(transformed.production_rules);
+    start_symbol = std::move(transformed.start_symbol);
+    probabilities.clear();
+    invalidate();
+    printParseTable(table);
+    return true;
+}
+
+void CFG::printParseTable(ParseTable &table) const {
+
+    std::cout << ">>> Building LL(1) Table" << std::endl;
+
+    std::cout << " >> FIRST:" << std::endl;
+    for (const auto &variable: variables) {
+        std::cout << "    " + variable + ": " + Logger::setToString(table.firstSet[variable]) << std::endl;
+    }
+
+    std::cout << " >> FOLLOW:" << std::endl;
+    for (const auto &variable: variables) {
+        std::cout << "    " + variable + ": " + Logger::setToString(table.followSet[variable]) << std::endl;
+    }
 
     std::cout << ">>> Table is built.\n" << std::endl;
     std::cout << "-------------------------------------\n" << std::endl;
@@ -270,6 +554,7 @@ ParseTable::ParseTable(const StringSet &variables, StringSet symbols) : variable
 void ParseTable::setParseRule(const std::string &variable, const std::string &symbol, const std::string &production) {
     if (!Table[variable][symbol].empty() && (Table[variable][symbol] != production)) {
         ParseTable::Table[variable][symbol] = "<ERR>";
+        conflicts = true;
         return;
     }
     ParseTable::Table[variable][symbol] = production;
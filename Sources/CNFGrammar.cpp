@@ -0,0 +1,68 @@
+//
+// Created by 2005e on 18/10/2026.
+//
+
+#include "../Headers/CNFGrammar.h"
+
+bool CNFGrammar::isCNF(const IndexedGrammar &grammar) {
+    bool start_in_body = false;
+    bool start_nullable = false;
+    for (std::size_t p = 0; p < grammar.heads.size(); p++) {
+        const auto &body = grammar.bodies[p];
+        if (body.empty()) {
+            if (grammar.heads[p] != grammar.start) {
+                return false;
+            }
+            start_nullable = true;
+        } else if (body.size() == 1) {
+            if (grammar.isVariable(body[0])) {
+                return false;
+            }
+        } else if (body.size() == 2) {
+            if (!grammar.isVariable(body[0]) || !grammar.isVariable(body[1])) {
+                return false;
+            }
+            start_in_body = start_in_body || body[0] == grammar.start || body[1] == grammar.start;
+        } else {
+            return false;
+        }
+    }
+    return !(start_nullable && start_in_body);
+}
+
+CNFGrammar::CNFGrammar(const CFG &cfg) : grammar(cfg) {
+    if (!isCNF(grammar)) {
+        throw (std::runtime_error("CNFGrammar error::the CFG is not in Chomsky normal form"));
+    }
+    variable_count = grammar.variable_count;
+    terminal_count = static_cast<int>(grammar.symbols.size()) - variable_count;
+    start = grammar.start;
+    words = (variable_count + 63) / 64;
+
+    terminal_rules.resize(terminal_count);
+    rules_by_left.resize(variable_count);
+    rules_by_head.resize(variable_count);
+    for (std::size_t p = 0; p < grammar.heads.size(); p++) {
+        const auto &body = grammar.bodies[p];
+        int production = static_cast<int>(p);
+        if (body.empty()) {
+            accepts_empty = true;
+        } else if (body.size() == 1) {
+            terminal_rules[body[0] - variable_count].push_back({grammar.heads[p], production});
+        } else {
+            rules_by_left[body[0]].push_back(static_cast<int>(binary_rules.size()));
+            rules_by_head[grammar.heads[p]].push_back(static_cast<int>(binary_rules.size()));
+            binary_rules.push_back({grammar.heads[p], body[0], body[1], production});
+        }
+    }
+}
+
+std::vector<int> CNFGrammar::tokenize(const std::string &input) const {
+    std::vector<int> tokens = grammar.tokenize(input);
+    for (int &token: tokens) {
+        if (token >= 0) {
+            token -= variable_count;
+        }
+    }
+    return tokens;
+}
@@ -0,0 +1,309 @@
+//
+// Created by 2005e on 18/10/2026.
+//
+
+#include "../Headers/DFA.h"
+
+#include <algorithm>
+
+DFA::Linearity DFA::linearity(const IndexedGrammar &grammar) {
+    bool right = true;
+    bool left = true;
+    for (const auto &body: grammar.bodies) {
+        for (std::size_t i = 0; i < body.size(); i++) {
+            if (grammar.isVariable(body[i])) {
+                right = right && i + 1 == body.size();
+                left = left && i == 0;
+            }
+        }
+    }
+    if (right) {
+        return Linearity::Right;
+    }
+    return left ? Linearity::Left : Linearity::None;
+}
+
+DFA::DFA(const CFG &cfg, std::size_t max_states) {
+
+    IndexedGrammar grammar(cfg);
+    Linearity kind = linearity(grammar);
+    if (kind == Linearity::None) {
+        throw (std::runtime_error("DFA error::the CFG is not regular"));
+    }
+    const int variable_count = grammar.variable_count;
+    column_count = static_cast<int>(grammar.symbols.size()) - variable_count;
+
+    // NFA: the variables are states, plus a final state (right-linear) or an initial state (left-linear)
+    std::vector<std::vector<std::pair<int, int>>> edges(variable_count + 1);
+    const int extra = variable_count;
+    auto newState = [&edges]() {
+        edges.emplace_back();
+        return static_cast<int>(edges.size()) - 1;
+    };
+    // Adds a path from -> to that reads the terminals in [begin, end), an epsilon edge if there are none
+    auto addChain = [&](int from, std::vector<int>::const_iterator begin, std::vector<int>::const_iterator end,
+                        int to) {
+        if (begin == end) {
+            edges[from].emplace_back(-1, to);
+            return;
+        }
+        for (auto it = begin; it != end; it++) {
+            int next = it + 1 == end ? to : newState();
+            edges[from].emplace_back(*it - variable_count, next);
+            from = next;
+        }
+    };
+    for (std::size_t p = 0; p < grammar.heads.size(); p++) {
+        const auto &body = grammar.bodies[p];
+        int head = grammar.heads[p];
+        if (kind == Linearity::Right) {
+            if (!body.empty() && grammar.isVariable(body.back())) {
+                addChain(head, body.begin(), body.end() - 1, body.back());
+            } else {
+                addChain(head, body.begin(), body.end(), extra);
+            }
+        } else {
+            if (!body.empty() && grammar.isVariable(body.front())) {
+                addChain(body.front(), body.begin() + 1, body.end(), head);
+            } else {
+                addChain(extra, body.begin(), body.end(), head);
+            }
+        }
+    }
+    int nfa_start = kind == Linearity::Right ? grammar.start : extra;
+    int nfa_accept = kind == Linearity::Right ? extra : grammar.start;
+
+    // Subset construction
+    auto closure = [&edges](const std::vector<int> &targets) {
+        std::vector<bool> seen(edges.size(), false);
+        std::vector<int> states;
+        for (int state: targets) {
+            if (!seen[state]) {
+                seen[state] = true;
+                states.push_back(state);
+            }
+        }
+        std::vector<int> worklist = states;
+        while (!worklist.empty()) {
+            int state = worklist.back();
+            worklist.pop_back();
+            for (const auto &edge: edges[state]) {
+                if (edge.first == -1 && !seen[edge.second]) {
+                    seen[edge.second] = true;
+                    states.push_back(edge.second);
+                    worklist.push_back(edge.second);
+                }
+            }
+        }
+        std::sort(states.begin(), states.end());
+        return states;
+    };
+
+    std::map<std::vector<int>, int> subsets;
+    std::vector<std::vector<int>> pending{closure({nfa_start})};
+    subsets[pending.front()] = 0;
+    for (std::size_t current = 0; current < pending.size(); current++) {
+        std::vector<std::vector<int>> targets(column_count);
+        for (int state: pending[current]) {
+            for (const auto &edge: edges[state]) {
+                if (edge.first >= 0) {
+                    targets[edge.first].push_back(edge.second);
+                }
+            }
+        }
+        accepting.push_back(std::binary_search(pending[current].begin(), pending[current].end(), nfa_accept));
+        for (int column = 0; column < column_count; column++) {
+            if (targets[column].empty()) {
+                table.push_back(-1);
+                continue;
+            }
+            std::vector<int> target = closure(targets[column]);
+            auto it = subsets.find(target);
+            if (it == subsets.end()) {
+                if (max_states > 0 && pending.size() >= max_states) {
+                    throw (std::runtime_error("DFA error::the subset construction exceeds the state limit"));
+                }
+                it = subsets.emplace(target, static_cast<int>(pending.size())).first;
+                pending.push_back(std::move(target));
+            }
+            table.push_back(it->second);
+        }
+    }
+    state_count = static_cast<int>(pending.size());
+    start = 0;
+
+    minimize();
+
+    char_columns.fill(-1);
+    for (int symbol = variable_count; symbol < static_cast<int>(grammar.symbols.size()); symbol++) {
+        if (grammar.symbols[symbol].size() == 1) {
+            char_columns[static_cast<unsigned char>(grammar.symbols[symbol][0])] = symbol - variable_count;
+        }
+    }
+}
+
+void DFA::minimize() {
+
+    // Make the DFA complete with an explicit dead state
+    const int dead = state_count;
+    const int n = state_count + 1;
+    std::vector<int> delta(static_cast<std::size_t>(n) * column_count, dead);
+    for (std::size_t i = 0; i < table.size(); i++) {
+        if (table[i] >= 0) {
+            delta[i] = table[i];
+        }
+    }
+    std::vector<bool> final_states = accepting;
+    final_states.push_back(false);
+
+    // Predecessors per column in compressed form: inverse[offsets[c * n + q] ..] are the p with delta(p, c) = q
+    std::vector<int> offsets(static_cast<std::size_t>(n) * column_count + 1, 0);
+    for (int p = 0; p < n; p++) {
+        for (int c = 0; c < column_count; c++) {
+            offsets[static_cast<std::size_t>(c) * n + delta[static_cast<std::size_t>(p) * column_count + c] + 1]++;
+        }
+    }
+    for (std::size_t i = 1; i < offsets.size(); i++) {
+        offsets[i] += offsets[i - 1];
+    }
+    std::vector<int> inverse(offsets.back());
+    std::vector<int> fill(offsets.begin(), offsets.end() - 1);
+    for (int p = 0; p < n; p++) {
+        for (int c = 0; c < column_count; c++) {
+            inverse[fill[static_cast<std::size_t>(c) * n + delta[static_cast<std::size_t>(p) * column_count + c]]++] = p;
+        }
+    }
+
+    // Partition as a permutation of the states, block b owns elements[first[b] .. end[b]),
+    // the marked states of a block are moved to elements[first[b] .. marked_end[b])
+    std::vector<int> elements(n);
+    std::vector<int> location(n);
+    std::vector<int> block_of(n);
+    std::vector<int> first;
+    std::vector<int> end;
+    std::vector<int> marked_end;
+    int position = 0;
+    for (bool final: {true, false}) {
+        int begin = position;
+        for (int q = 0; q < n; q++) {
+            if (final_states[q] == final) {
+                elements[position] = q;
+                location[q] = position++;
+                block_of[q] = static_cast<int>(first.size());
+            }
+        }
+        if (position > begin) {
+            first.push_back(begin);
+            end.push_back(position);
+            marked_end.push_back(begin);
+        }
+    }
+
+    std::vector<bool> waiting(first.size(), true);
+    std::vector<int> worklist;
+    for (int b = 0; b < static_cast<int>(first.size()); b++) {
+        worklist.push_back(b);
+    }
+
+    std::vector<int> touched;
+    while (!worklist.empty()) {
+        int splitter = worklist.back();
+        worklist.pop_back();
+        waiting[splitter] = false;
+        std::vector<int> members(elements.begin() + first[splitter], elements.begin() + end[splitter]);
+
+        for (int c = 0; c < column_count; c++) {
+            // Mark every predecessor of the splitter
+            for (int q: members) {
+                std::size_t index = static_cast<std::size_t>(c) * n + q;
+                for (int i = offsets[index]; i < offsets[index + 1]; i++) {
+                    int p = inverse[i];
+                    int b = block_of[p];
+                    if (location[p] < marked_end[b]) {
+                        continue;
+                    }
+                    if (marked_end[b] == first[b]) {
+                        touched.push_back(b);
+                    }
+                    int other = elements[marked_end[b]];
+                    std::swap(elements[location[p]], elements[marked_end[b]]);
+                    location[other] = location[p];
+                    location[p] = marked_end[b]++;
+                }
+            }
+            // Split the touched blocks into their marked and unmarked part
+            for (int b: touched) {
+                if (marked_end[b] == end[b]) {
+                    marked_end[b] = first[b];
+                    continue;
+                }
+                int split = static_cast<int>(first.size());
+                first.push_back(first[b]);
+                end.push_back(marked_end[b]);
+                marked_end.push_back(first[b]);
+                first[b] = marked_end[b];
+                marked_end[b] = first[b];
+                for (int i = first[split]; i < end[split]; i++) {
+                    block_of[elements[i]] = split;
+                }
+                if (waiting[b]) {
+                    waiting.push_back(true);
+                    worklist.push_back(split);
+                } else {
+                    bool smaller = end[split] - first[split] <= end[b] - first[b];
+                    waiting.push_back(smaller);
+                    worklist.push_back(smaller ? split : b);
+                    waiting[b] = waiting[b] || !smaller;
+                }
+            }
+            touched.clear();
+        }
+    }
+
+    // Renumber the blocks from the start state in breadth-first order, the block of the dead state is dropped
+    int dead_block = block_of[dead];
+    std::vector<int> number(first.size(), -1);
+    std::vector<int> order{block_of[start]};
+    number[block_of[start]] = 0;
+    for (std::size_t i = 0; i < order.size(); i++) {
+        int representative = elements[first[order[i]]];
+        for (int c = 0; c < column_count; c++) {
+            int target = block_of[delta[static_cast<std::size_t>(representative) * column_count + c]];
+            if (target != dead_block && number[target] == -1) {
+                number[target] = static_cast<int>(order.size());
+                order.push_back(target);
+            }
+        }
+    }
+
+    std::vector<int> minimal_table(order.size() * column_count, -1);
+    std::vector<bool> minimal_accepting(order.size(), false);
+    for (std::size_t i = 0; i < order.size(); i++) {
+        int representative = elements[first[order[i]]];
+        minimal_accepting[i] = final_states[representative];
+        for (int c = 0; c < column_count; c++) {
+            int target = block_of[delta[static_cast<std::size_t>(representative) * column_count + c]];
+            minimal_table[i * column_count + c] = target == dead_block ? -1 : number[target];
+        }
+    }
+    table = std::move(minimal_table);
+    accepting = std::move(minimal_accepting);
+    state_count = static_cast<int>(order.size());
+    start = 0;
+}
+
+bool DFA::accepts(const std::string &input) const {
+    int state = start;
+    for (char c: input) {
+        int column = char_columns[static_cast<unsigned char>(c)];
+        if (column < 0 || state < 0) {
+            return false;
+        }
+        state = table[static_cast<std::size_t>(state) * column_count + column];
+    }
+    return state >= 0 && accepting[state];
+}
+
+int DFA::size() const {
+    return state_count;
+}
@@ -0,0 +1,167 @@
+//
+// Created by 2005e on 18/10/2026.
+//
+
+#include "../Headers/DPDA.h"
+
+DPDA::DPDA(const PDA &pda, std::size_t stack_capacity) : stack_capacity{stack_capacity} {
+
+    if (!pda.isDeterministic()) {
+        throw (std::runtime_error("DPDA error::the PDA is not deterministic"));
+    }
+
+    // Number the states, input symbols and stack symbols
+    std::map<std::string, int> state_ids;
+    std::map<std::string, int> symbol_ids;
+    auto state_id = [&state_ids](const std::string &state) {
+        return state_ids.emplace(state, static_cast<int>(state_ids.size())).first->second;
+    };
+    auto symbol_id = [&symbol_ids](const std::string &symbol) {
+        return symbol_ids.emplace(symbol, static_cast<int>(symbol_ids.size())).first->second;
+    };
+    auto input_column = [this](const std::string &input) {
+        return input_columns.emplace(input, static_cast<int>(input_columns.size()) + 1).first->second;
+    };
+
+    for (const auto &state: pda.getStates()) {
+        state_id(state);
+    }
+    for (const auto &symbol: pda.getStackAlphabet()) {
+        symbol_id(symbol);
+    }
+    for (const auto &input: pda.getInputAlphabet()) {
+        if (!input.empty()) {
+            input_column(input);
+        }
+    }
+    start_state = state_id(pda.getStartState());
+    start_symbol = symbol_id(pda.getStartSymbol());
+    for (const auto &transition: pda.getTransitions()) {
+        state_id(std::get<0>(transition.first));
+        symbol_id(std::get<2>(transition.first));
+        if (!std::get<1>(transition.first).empty()) {
+            input_column(std::get<1>(transition.first));
+        }
+        for (const auto &next: transition.second) {
+            state_id(next.first);
+            for (const auto &symbol: next.second) {
+                symbol_id(symbol);
+            }
+        }
+    }
+
+    state_count = static_cast<int>(state_ids.size());
+    symbol_count = static_cast<int>(symbol_ids.size());
+    input_count = static_cast<int>(input_columns.size()) + 1;
+
+    char_columns.fill(-1);
+    for (const auto &input: input_columns) {
+        if (input.first.size() == 1) {
+            char_columns[static_cast<unsigned char>(input.first[0])] = input.second;
+        }
+    }
+
+    // Build the flat transition table
+    table.assign(static_cast<std::size_t>(state_count) * input_count * symbol_count, -1);
+    epsilon.assign(static_cast<std::size_t>(state_count) * symbol_count, false);
+    for (const auto &transition: pda.getTransitions()) {
+        const auto &next = *transition.second.begin();
+        int state = state_ids[std::get<0>(transition.first)];
+        int top = symbol_ids[std::get<2>(transition.first)];
+        int column = std::get<1>(transition.first).empty() ? 0 : input_columns[std::get<1>(transition.first)];
+
+        Move move{state_ids[next.first], static_cast<int>(push_symbols.size()), static_cast<int>(next.second.size())};
+        // The first symbol of the replacement becomes the new top, so the symbols are stored bottom to top
+        for (auto it = next.second.rbegin(); it != next.second.rend(); it++) {
+            push_symbols.push_back(symbol_ids[*it]);
+        }
+        table[(static_cast<std::size_t>(state) * input_count + column) * symbol_count + top] =
+                static_cast<int>(moves.size());
+        moves.push_back(move);
+        if (column == 0) {
+            epsilon[static_cast<std::size_t>(state) * symbol_count + top] = true;
+        }
+    }
+}
+
+bool DPDA::accepts(const std::string &input) const {
+    std::vector<int> columns;
+    columns.reserve(input.size());
+    for (char c: input) {
+        columns.push_back(char_columns[static_cast<unsigned char>(c)]);
+    }
+    return run(columns);
+}
+
+bool DPDA::accepts(const std::vector<std::string> &input) const {
+    std::vector<int> columns;
+    columns.reserve(input.size());
+    for (const auto &symbol: input) {
+        auto it = input_columns.find(symbol);
+        columns.push_back(it == input_columns.end() ? -1 : it->second);
+    }
+    return run(columns);
+}
+
+bool DPDA::run(const std::vector<int> &columns) const {
+
+    std::vector<int> stack(stack_capacity);
+    // The step in which each stack slot was last written, used to detect epsilon loops
+    std::vector<std::size_t> written(stack_capacity, 0);
+    // The (height, step) of the last epsilon move taken from each (state, stacktop) pair
+    const std::size_t never = static_cast<std::size_t>(-1);
+    std::vector<std::pair<std::size_t, std::size_t>> visits(static_cast<std::size_t>(state_count) * symbol_count,
+                                                            {0, never});
+
+    if (stack_capacity == 0) {
+        throw (std::runtime_error("DPDA error::stack capacity exceeded"));
+    }
+    std::size_t height = 0;
+    stack[height++] = start_symbol;
+    int state = start_state;
+
+    std::size_t position = 0;
+    std::size_t step = 1;
+    // The step in which the current run of epsilon moves started
+    std::size_t epsilon_start = step;
+
+    while (height > 0) {
+        int top = stack[height - 1];
+        std::size_t pair = static_cast<std::size_t>(state) * symbol_count + top;
+        int index;
+
+        if (epsilon[pair]) {
+            // Reaching the same (state, stacktop) without touching the stack below means the DPDA loops forever
+            auto &visit = visits[pair];
+            if (visit.second != never && visit.second >= epsilon_start && height >= visit.first &&
+                (visit.first < 2 || written[visit.first - 2] < visit.second)) {
+                return false;
+            }
+            visit = {height, step};
+            index = table[static_cast<std::size_t>(state) * input_count * symbol_count + top];
+        } else {
+            if (position == columns.size() || columns[position] < 0) {
+                return false;
+            }
+            index = table[(static_cast<std::size_t>(state) * input_count + columns[position]) * symbol_count + top];
+            if (index < 0) {
+                return false;
+            }
+            position++;
+            epsilon_start = step + 1;
+        }
+
+        const Move &move = moves[index];
+        height--;
+        if (height + move.push_length > stack_capacity) {
+            throw (std::runtime_error("DPDA error::stack capacity exceeded"));
+        }
+        for (int i = 0; i < move.push_length; i++) {
+            written[height] = step;
+            stack[height++] = push_symbols[move.push_offset + i];
+        }
+        state = move.next_state;
+        step++;
+    }
+    return position == columns.size();
+}
@@ -0,0 +1,111 @@
+//
+// Created by 2005e on 18/10/2026.
+//
+
+#include <unordered_map>
+#include <unordered_set>
+
+#include "../Headers/EarleyParser.h"
+#include "../Headers/GrammarCleanup.h"
+
+EarleyParser::EarleyParser(const CFG &cfg) : grammar(cfg) {
+    nullable = GrammarCleanup::nullable(grammar);
+    std::size_t offset = 0;
+    for (const auto &body: grammar.bodies) {
+        item_offsets.push_back(offset);
+        offset += body.size() + 1;
+    }
+}
+
+namespace {
+    /**
+     * An Earley item: a production with a dot position and the position where the item started
+     */
+    struct EarleyItem {
+        int production;
+        int dot;
+        std::size_t origin;
+    };
+
+    /**
+     * The items of one position, deduplicated by dotted item and origin
+     */
+    struct EarleySet {
+        std::vector<EarleyItem> items;
+        std::unordered_set<std::uint64_t> keys;
+        /**
+         * The items that wait for a variable (the symbol after their dot)
+         */
+        std::unordered_map<int, std::vector<int>> waiting;
+    };
+}
+
+bool EarleyParser::accepts(const std::string &input) const {
+    std::vector<int> tokens = grammar.tokenize(input);
+    for (int token: tokens) {
+        if (token < 0) {
+            return false;
+        }
+    }
+    std::size_t n = tokens.size();
+    std::vector<EarleySet> sets(n + 1);
+
+    auto add = [this, &sets](std::size_t position, int production, int dot, std::size_t origin) {
+        std::uint64_t key = (static_cast<std::uint64_t>(item_offsets[production] + dot) << 32) | origin;
+        EarleySet &set = sets[position];
+        if (!set.keys.insert(key).second) {
+            return;
+        }
+        const auto &body = grammar.bodies[production];
+        if (dot < static_cast<int>(body.size()) && grammar.isVariable(body[dot])) {
+            set.waiting[body[dot]].push_back(static_cast<int>(set.items.size()));
+        }
+        set.items.push_back({production, dot, origin});
+    };
+
+    for (int production: grammar.rules[grammar.start]) {
+        add(0, production, 0, 0);
+    }
+    for (std::size_t position = 0; position <= n; position++) {
+        EarleySet &set = sets[position];
+        for (std::size_t index = 0; index < set.items.size(); index++) {
+            EarleyItem item = set.items[index];
+            const auto &body = grammar.bodies[item.production];
+            if (item.dot == static_cast<int>(body.size())) {
+                // Complete
+                int head = grammar.heads[item.production];
+                const EarleySet &origin = sets[item.origin];
+                auto it = origin.waiting.find(head);
+                if (it == origin.waiting.end()) {
+                    continue;
+                }
+                // The waiting list of the current set can grow while iterating, so index by position
+                const std::vector<int> &parents = it->second;
+                for (std::size_t w = 0; w < parents.size(); w++) {
+                    EarleyItem parent = origin.items[parents[w]];
+                    add(position, parent.production, parent.dot + 1, parent.origin);
+                }
+            } else if (grammar.isVariable(body[item.dot])) {
+                // Predict
+                int variable = body[item.dot];
+                for (int production: grammar.rules[variable]) {
+                    add(position, production, 0, position);
+                }
+                if (nullable[variable]) {
+                    add(position, item.production, item.dot + 1, item.origin);
+                }
+            } else if (position < n && body[item.dot] == tokens[position]) {
+                // Scan
+                add(position + 1, item.production, item.dot + 1, item.origin);
+            }
+        }
+    }
+
+    for (const auto &item: sets[n].items) {
+        if (item.origin == 0 && grammar.heads[item.production] == grammar.start &&
+            item.dot == static_cast<int>(grammar.bodies[item.production].size())) {
+            return true;
+        }
+    }
+    return false;
+}
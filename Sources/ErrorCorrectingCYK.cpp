@@ -0,0 +1,254 @@
+//
+// Created by 2005e on 18/10/2026.
+//
+
+#include <algorithm>
+#include <functional>
+#include <queue>
+
+#include "../Headers/ErrorCorrectingCYK.h"
+
+ErrorCorrectingCYK::ErrorCorrectingCYK(const CFG &cfg) : grammar(cfg), rules_by_right(grammar.variable_count) {
+    for (std::size_t r = 0; r < grammar.binary_rules.size(); r++) {
+        rules_by_right[grammar.binary_rules[r].right].push_back(static_cast<int>(r));
+    }
+}
+
+namespace {
+    const double unreachable = std::numeric_limits<double>::infinity();
+
+    /**
+     * How the cheapest derivation of a variable over a span (or over nothing) was built
+     */
+    enum class Step {
+        None,
+        /**
+         * A terminal rule, rule is its production id
+         */
+        Terminal,
+        /**
+         * A binary rule, rule indexes the binary rules and split is the length of the left part (0 or the whole
+         * span if one part is empty)
+         */
+        Binary,
+        /**
+         * The whole span is deleted and the shortest string of the variable is inserted
+         */
+        Erase,
+        /**
+         * The epsilon production of the start symbol
+         */
+        Epsilon
+    };
+
+    struct CorrectionEntry {
+        double cost = unreachable;
+        Step step = Step::None;
+        int rule = -1;
+        std::size_t split = 0;
+    };
+
+    /**
+     * A variable of a cell that survived the pruning, with its cheapest derivation
+     */
+    struct LiveEntry {
+        int variable;
+        CorrectionEntry entry;
+    };
+}
+
+Correction ErrorCorrectingCYK::correct(const std::string &input, const CorrectionOptions &options) const {
+    const EditCosts &costs = options.costs;
+    if (!(costs.insertion > 0.0 && costs.deletion > 0.0 && costs.substitution > 0.0)) {
+        throw (std::runtime_error("ErrorCorrectingCYK error::the edit costs have to be positive"));
+    }
+    const IndexedGrammar &indexed = grammar.grammar;
+    const std::size_t n = input.size();
+    const std::size_t variables = grammar.variable_count;
+    const std::size_t terminals = grammar.terminal_count;
+
+    // The cheapest way to derive nothing from the input: insert the shortest string (Bellman-Ford over the rules)
+    std::vector<CorrectionEntry> empty(variables);
+    if (grammar.accepts_empty) {
+        empty[grammar.start] = {0.0, Step::Epsilon, -1, 0};
+    }
+    for (const auto &rules: grammar.terminal_rules) {
+        for (const auto &rule: rules) {
+            if (costs.insertion < empty[rule.head].cost) {
+                empty[rule.head] = {costs.insertion, Step::Terminal, rule.production, 0};
+            }
+        }
+    }
+    bool changed = true;
+    while (changed) {
+        changed = false;
+        for (std::size_t r = 0; r < grammar.binary_rules.size(); r++) {
+            const auto &rule = grammar.binary_rules[r];
+            double cost = empty[rule.left].cost + empty[rule.right].cost;
+            if (cost < empty[rule.head].cost) {
+                empty[rule.head] = {cost, Step::Binary, static_cast<int>(r), 0};
+                changed = true;
+            }
+        }
+    }
+
+    // occurrences[p * terminals + t] counts terminal t in input[0 .. p)
+    std::vector<int> tokens = grammar.tokenize(input);
+    std::vector<std::size_t> occurrences((n + 1) * terminals, 0);
+    for (std::size_t p = 0; p < n; p++) {
+        std::copy_n(&occurrences[p * terminals], terminals, &occurrences[(p + 1) * terminals]);
+        if (tokens[p] >= 0) {
+            occurrences[(p + 1) * terminals + tokens[p]]++;
+        }
+    }
+
+    // Only the live variables of a cell are stored, sorted by variable: cell (i, j) spans input[i .. j) and its
+    // entries are entries[ranges[j * (j - 1) / 2 + i]] (the triangular column order of IncrementalCYK)
+    std::vector<LiveEntry> entries;
+    std::vector<std::pair<std::size_t, std::size_t>> ranges(n * (n + 1) / 2, {0, 0});
+    auto cellIndex = [](std::size_t i, std::size_t length) {
+        std::size_t end = i + length;
+        return end * (end - 1) / 2 + i;
+    };
+
+    // The cell that is being computed and the right part of the current split, as dense rows over the variables
+    std::vector<CorrectionEntry> target(variables);
+    std::vector<double> right(variables, unreachable);
+
+    using QueueItem = std::pair<double, int>;
+    std::priority_queue<QueueItem, std::vector<QueueItem>, std::greater<>> queue;
+    std::vector<int> touched;
+    std::vector<bool> is_touched(variables, false);
+    auto relax = [&](int head, double cost, Step step, int rule, std::size_t split) {
+        if (cost > options.max_cost || cost >= target[head].cost) {
+            return;
+        }
+        if (!is_touched[head]) {
+            is_touched[head] = true;
+            touched.push_back(head);
+        }
+        target[head] = {cost, step, rule, split};
+        queue.emplace(cost, head);
+    };
+
+    for (std::size_t length = 1; length <= n; length++) {
+        for (std::size_t i = 0; i + length <= n; i++) {
+            const double deleted = static_cast<double>(length - 1) * costs.deletion;
+
+            // One character becomes the terminal (matched or substituted), the others are deleted
+            for (std::size_t t = 0; t < terminals; t++) {
+                bool occurs = occurrences[(i + length) * terminals + t] > occurrences[i * terminals + t];
+                double cost = occurs ? deleted : deleted + std::min(costs.substitution, costs.deletion + costs.insertion);
+                for (const auto &rule: grammar.terminal_rules[t]) {
+                    relax(rule.head, cost, Step::Terminal, rule.production, 0);
+                }
+            }
+            for (std::size_t v = 0; v < variables; v++) {
+                if (empty[v].cost < unreachable) {
+                    relax(static_cast<int>(v), deleted + costs.deletion + empty[v].cost, Step::Erase, -1, 0);
+                }
+            }
+            for (std::size_t split = 1; split < length; split++) {
+                auto [left_begin, left_end] = ranges[cellIndex(i, split)];
+                auto [right_begin, right_end] = ranges[cellIndex(i + split, length - split)];
+                if (left_begin == left_end || right_begin == right_end) {
+                    continue;
+                }
+                for (std::size_t e = right_begin; e < right_end; e++) {
+                    right[entries[e].variable] = entries[e].entry.cost;
+                }
+                for (std::size_t e = left_begin; e < left_end; e++) {
+                    const LiveEntry &left = entries[e];
+                    for (int r: grammar.rules_by_left[left.variable]) {
+                        const auto &rule = grammar.binary_rules[r];
+                        if (right[rule.right] < unreachable) {
+                            relax(rule.head, left.entry.cost + right[rule.right], Step::Binary, r, split);
+                        }
+                    }
+                }
+                for (std::size_t e = right_begin; e < right_end; e++) {
+                    right[entries[e].variable] = unreachable;
+                }
+            }
+
+            // Rules with one empty part connect the variables of this cell, settle them cheapest first
+            while (!queue.empty()) {
+                auto [cost, variable] = queue.top();
+                queue.pop();
+                if (cost > target[variable].cost) {
+                    continue;
+                }
+                for (int r: grammar.rules_by_left[variable]) {
+                    const auto &rule = grammar.binary_rules[r];
+                    relax(rule.head, cost + empty[rule.right].cost, Step::Binary, r, length);
+                }
+                for (int r: rules_by_right[variable]) {
+                    const auto &rule = grammar.binary_rules[r];
+                    relax(rule.head, empty[rule.left].cost + cost, Step::Binary, r, 0);
+                }
+            }
+
+            // Store the variables within the beam of the cheapest one and clear the row for the next cell
+            double best = unreachable;
+            for (int variable: touched) {
+                is_touched[variable] = false;
+                best = std::min(best, target[variable].cost);
+            }
+            std::sort(touched.begin(), touched.end());
+            std::size_t begin = entries.size();
+            for (int variable: touched) {
+                if (target[variable].cost <= best + options.beam) {
+                    entries.push_back({variable, target[variable]});
+                }
+                target[variable] = CorrectionEntry();
+            }
+            ranges[cellIndex(i, length)] = {begin, entries.size()};
+            touched.clear();
+        }
+    }
+
+    // The entry of a variable in a cell, null if it did not survive
+    auto find = [&](int variable, std::size_t i, std::size_t length) -> const CorrectionEntry * {
+        auto [begin, end] = ranges[cellIndex(i, length)];
+        auto it = std::lower_bound(entries.begin() + static_cast<std::ptrdiff_t>(begin),
+                                   entries.begin() + static_cast<std::ptrdiff_t>(end), variable,
+                                   [](const LiveEntry &entry, int id) { return entry.variable < id; });
+        return it != entries.begin() + static_cast<std::ptrdiff_t>(end) && it->variable == variable ? &it->entry
+                                                                                                     : nullptr;
+    };
+
+    Correction result;
+    const CorrectionEntry *root = n == 0 ? &empty[grammar.start] : find(grammar.start, 0, n);
+    if (!root || root->cost == unreachable || root->cost > options.max_cost) {
+        return result;
+    }
+    result.found = true;
+    result.cost = root->cost;
+
+    // Follows the steps back, a span of length 0 uses the derivations of nothing
+    std::function<void(int, std::size_t, std::size_t)> build = [&](int variable, std::size_t i, std::size_t length) {
+        const CorrectionEntry &entry = length == 0 ? empty[variable] : *find(variable, i, length);
+        switch (entry.step) {
+            case Step::Terminal:
+                result.nearest += indexed.symbols[indexed.bodies[entry.rule][0]];
+                break;
+            case Step::Binary: {
+                const auto &rule = grammar.binary_rules[entry.rule];
+                build(rule.left, i, entry.split);
+                build(rule.right, i + entry.split, length - entry.split);
+                break;
+            }
+            case Step::Erase:
+                build(variable, i, 0);
+                break;
+            default:
+                break;
+        }
+    };
+    build(grammar.start, 0, n);
+    return result;
+}
+
+const CNFGrammar &ErrorCorrectingCYK::getGrammar() const {
+    return grammar;
+}
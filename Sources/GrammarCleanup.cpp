@@ -0,0 +1,140 @@
+//
+// Created by 2005e on 18/10/2026.
+//
+
+#include "../Headers/GrammarCleanup.h"
+
+void GrammarCleanup::propagate(const IndexedGrammar &grammar, std::vector<bool> &marked) {
+
+    std::size_t production_count = grammar.heads.size();
+
+    // remaining[p] is the number of symbols in the body of p that are not marked yet
+    std::vector<std::size_t> remaining(production_count, 0);
+    // occurrences[offsets[s] .. offsets[s + 1]) are the productions in which symbol s occurs (once per occurrence)
+    std::vector<std::size_t> offsets(grammar.symbols.size() + 1, 0);
+    for (std::size_t p = 0; p < production_count; p++) {
+        for (int symbol: grammar.bodies[p]) {
+            offsets[symbol + 1]++;
+        }
+    }
+    for (std::size_t s = 0; s < grammar.symbols.size(); s++) {
+        offsets[s + 1] += offsets[s];
+    }
+    std::vector<std::size_t> occurrences(offsets.back());
+    std::vector<std::size_t> fill(offsets.begin(), offsets.end() - 1);
+    for (std::size_t p = 0; p < production_count; p++) {
+        for (int symbol: grammar.bodies[p]) {
+            occurrences[fill[symbol]++] = p;
+            if (!marked[symbol]) {
+                remaining[p]++;
+            }
+        }
+    }
+
+    std::vector<int> worklist;
+    for (std::size_t p = 0; p < production_count; p++) {
+        if (remaining[p] == 0 && !marked[grammar.heads[p]]) {
+            marked[grammar.heads[p]] = true;
+            worklist.push_back(grammar.heads[p]);
+        }
+    }
+    while (!worklist.empty()) {
+        int symbol = worklist.back();
+        worklist.pop_back();
+        for (std::size_t i = offsets[symbol]; i < offsets[symbol + 1]; i++) {
+            std::size_t p = occurrences[i];
+            if (--remaining[p] == 0 && !marked[grammar.heads[p]]) {
+                marked[grammar.heads[p]] = true;
+                worklist.push_back(grammar.heads[p]);
+            }
+        }
+    }
+}
+
+std::vector<bool> GrammarCleanup::nullable(const IndexedGrammar &grammar) {
+    std::vector<bool> marked(grammar.symbols.size(), false);
+    propagate(grammar, marked);
+    return marked;
+}
+
+std::vector<bool> GrammarCleanup::generating(const IndexedGrammar &grammar) {
+    std::vector<bool> marked(grammar.symbols.size(), false);
+    for (std::size_t symbol = grammar.variable_count; symbol < grammar.symbols.size(); symbol++) {
+        marked[symbol] = true;
+    }
+    propagate(grammar, marked);
+    return marked;
+}
+
+std::vector<bool> GrammarCleanup::reachable(const IndexedGrammar &grammar, const std::vector<bool> &usable) {
+    std::vector<bool> reached(grammar.symbols.size(), false);
+    std::vector<int> worklist{grammar.start};
+    reached[grammar.start] = true;
+    while (!worklist.empty()) {
+        int variable = worklist.back();
+        worklist.pop_back();
+        for (int p: grammar.rules[variable]) {
+            if (!usable[p]) {
+                continue;
+            }
+            for (int symbol: grammar.bodies[p]) {
+                if (!reached[symbol]) {
+                    reached[symbol] = true;
+                    if (grammar.isVariable(symbol)) {
+                        worklist.push_back(symbol);
+                    }
+                }
+            }
+        }
+    }
+    return reached;
+}
+
+CleanupReport GrammarCleanup::cleanup(CFG &cfg) {
+
+    IndexedGrammar grammar(cfg);
+    CleanupReport report;
+    report.variables_before = cfg.getVariables().size();
+    report.productions_before = grammar.heads.size();
+    report.size_before = grammar.size();
+
+    std::vector<bool> is_nullable = nullable(grammar);
+    for (int variable = 0; variable < grammar.variable_count; variable++) {
+        if (is_nullable[variable]) {
+            report.nullable.insert(grammar.symbols[variable]);
+        }
+    }
+
+    // A production is useful if all of its symbols are generating and its head is reachable
+    std::vector<bool> is_generating = generating(grammar);
+    std::vector<bool> usable(grammar.heads.size(), false);
+    for (std::size_t p = 0; p < grammar.heads.size(); p++) {
+        usable[p] = is_generating[grammar.heads[p]];
+        for (int symbol: grammar.bodies[p]) {
+            usable[p] = usable[p] && is_generating[symbol];
+        }
+    }
+    std::vector<bool> is_reachable = reachable(grammar, usable);
+
+    CFG cleaned;
+    cleaned.setStartSymbol(cfg.getStartSymbol());
+    cleaned.setTerminals(cfg.getTerminals());
+    for (int variable = 0; variable < grammar.variable_count; variable++) {
+        if ((is_generating[variable] && is_reachable[variable]) || variable == grammar.start) {
+            cleaned.addVariable(grammar.symbols[variable]);
+        } else if (cfg.getVariables().find(grammar.symbols[variable]) != cfg.getVariables().end()) {
+            report.removed.insert(grammar.symbols[variable]);
+        }
+    }
+    for (std::size_t p = 0; p < grammar.heads.size(); p++) {
+        if (usable[p] && is_reachable[grammar.heads[p]]) {
+            cleaned.addProductionRule(grammar.symbols[grammar.heads[p]], grammar.bodyString(static_cast<int>(p)));
+            report.productions_after++;
+            report.size_after += 1 + grammar.bodies[p].size();
+        }
+    }
+    report.variables_after = cleaned.getVariables().size();
+
+    cfg = cleaned;
+    return report;
+}
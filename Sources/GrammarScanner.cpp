@@ -0,0 +1,102 @@
+//
+// Created by 2005e on 18/10/2026.
+//
+
+#include "../Headers/GrammarScanner.h"
+
+#include <algorithm>
+
+GrammarScanner::GrammarScanner(const CFG &cfg, const std::string &variable, std::size_t max_length)
+        : grammar(cfg), max_length(max_length) {
+    if (max_length == 0) {
+        throw (std::runtime_error("GrammarScanner error::the maximum match length has to be positive"));
+    }
+    auto it = grammar.grammar.ids.find(variable);
+    if (it == grammar.grammar.ids.end() || !grammar.grammar.isVariable(it->second)) {
+        throw (std::runtime_error("GrammarScanner error::" + variable + " is not a variable"));
+    }
+    target = it->second;
+    columns.assign(max_length * max_length * grammar.words, 0);
+}
+
+void GrammarScanner::step(char symbol, const MatchCallback &callback) {
+    const std::size_t words = grammar.words;
+    auto cell = [this, words](std::size_t column, std::size_t length) {
+        return &columns[((column % max_length) * max_length + length - 1) * words];
+    };
+
+    // The new column ends at position j and overwrites the column that fell out of the window
+    const std::size_t j = ++position;
+    std::fill(cell(j, 1), cell(j, 1) + max_length * words, 0);
+
+    int terminal = grammar.grammar.char_terminals[static_cast<unsigned char>(symbol)];
+    if (terminal < 0 || grammar.terminal_rules[terminal - grammar.variable_count].empty()) {
+        // Every span that ends here needs a variable for the last character, so the column stays empty
+        return;
+    }
+    for (const auto &rule: grammar.terminal_rules[terminal - grammar.variable_count]) {
+        setBit(cell(j, 1), rule.head);
+    }
+
+    // Only the non-empty cells of this column can be the right half of a split
+    const std::size_t longest = std::min(max_length, j);
+    filled.assign(1, 1);
+    for (std::size_t length = 2; length <= longest; length++) {
+        std::uint64_t *target_cell = cell(j, length);
+        const std::size_t i = j - length;
+        for (std::size_t right_length: filled) {
+            // input[i .. i + split) is in an earlier column, input[i + split .. j) is a shorter cell of this column
+            const std::size_t split = length - right_length;
+            const std::uint64_t *right = cell(j, right_length);
+            forEachBit(cell(i + split, split), grammar.words, [&](int left) {
+                for (int index: grammar.rules_by_left[left]) {
+                    const auto &rule = grammar.binary_rules[index];
+                    if (testBit(right, rule.right)) {
+                        setBit(target_cell, rule.head);
+                    }
+                }
+            });
+        }
+        if (std::any_of(target_cell, target_cell + words, [](std::uint64_t word) { return word != 0; })) {
+            filled.push_back(length);
+        }
+    }
+    for (std::size_t length = 1; length <= longest; length++) {
+        if (testBit(cell(j, length), target)) {
+            callback({j - length, j});
+        }
+    }
+}
+
+void GrammarScanner::feed(const std::string &chunk, const MatchCallback &callback) {
+    for (char symbol: chunk) {
+        step(symbol, callback);
+    }
+}
+
+void GrammarScanner::scan(std::istream &stream, const MatchCallback &callback, std::size_t chunk_size) {
+    std::string chunk(chunk_size, '\0');
+    while (stream.read(chunk.data(), static_cast<std::streamsize>(chunk_size)) || stream.gcount() > 0) {
+        chunk.resize(static_cast<std::size_t>(stream.gcount()));
+        feed(chunk, callback);
+        chunk.resize(chunk_size);
+    }
+}
+
+std::vector<Span> GrammarScanner::find(const std::string &text) {
+    reset();
+    std::vector<Span> matches;
+    feed(text, [&matches](const Span &span) {
+        matches.push_back(span);
+    });
+    return matches;
+}
+
+void GrammarScanner::reset() {
+    position = 0;
+    std::fill(columns.begin(), columns.end(), 0);
+}
+
+std::size_t GrammarScanner::getPosition() const {
+    return position;
+}
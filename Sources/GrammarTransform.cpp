@@ -0,0 +1,338 @@
+//
+// Created by 2005e on 18/10/2026.
+//
+
+#include "../Headers/GrammarTransform.h"
+#include "../Headers/GrammarCleanup.h"
+
+#include <algorithm>
+#include <unordered_map>
+
+using Body = std::vector<std::string>;
+
+/**
+ * Returns the symbols of a body string
+ */
+Body splitBody(const std::string &body) {
+    Body symbols;
+    std::istringstream iss(body);
+    std::string symbol;
+    while (iss >> symbol) {
+        symbols.push_back(symbol);
+    }
+    return symbols;
+}
+
+/**
+ * Joins symbols to a body string
+ */
+std::string joinBody(const Body &symbols) {
+    std::string body;
+    for (const auto &symbol: symbols) {
+        if (!body.empty()) {
+            body += " ";
+        }
+        body += symbol;
+    }
+    return body;
+}
+
+/**
+ * Returns a variable name based on name that is not used yet, by adding primes
+ */
+std::string freshVariable(std::string name, StringSet &used) {
+    do {
+        name += "'";
+    } while (used.find(name) != used.end());
+    used.insert(name);
+    return name;
+}
+
+/**
+ * Builds a CFG with the alphabet and start symbol of cfg and the given productions
+ */
+CFG buildCFG(const CFG &cfg, const StringSet &variables, const std::map<std::string, std::vector<Body>> &productions) {
+    CFG result;
+    result.setStartSymbol(cfg.getStartSymbol());
+    result.setTerminals(cfg.getTerminals());
+    for (const auto &variable: variables) {
+        result.addVariable(variable);
+    }
+    for (const auto &rule: productions) {
+        result.addVariable(rule.first);
+        for (const auto &body: rule.second) {
+            result.addProductionRule(rule.first, joinBody(body));
+        }
+    }
+    return result;
+}
+
+bool GrammarTransform::isLeftRecursive(const CFG &cfg) {
+    IndexedGrammar grammar(cfg);
+    std::vector<bool> is_nullable = GrammarCleanup::nullable(grammar);
+
+    // Edge A -> B if B can be the leftmost symbol of a sentential form derived from A in one step
+    std::vector<std::vector<int>> edges(grammar.variable_count);
+    for (std::size_t p = 0; p < grammar.heads.size(); p++) {
+        for (int symbol: grammar.bodies[p]) {
+            if (!grammar.isVariable(symbol)) {
+                break;
+            }
+            edges[grammar.heads[p]].push_back(symbol);
+            if (!is_nullable[symbol]) {
+                break;
+            }
+        }
+    }
+
+    // Cycle detection with an iterative depth-first search
+    std::vector<int> color(grammar.variable_count, 0);
+    for (int root = 0; root < grammar.variable_count; root++) {
+        if (color[root] != 0) {
+            continue;
+        }
+        std::vector<std::pair<int, std::size_t>> stack{{root, 0}};
+        color[root] = 1;
+        while (!stack.empty()) {
+            auto &top = stack.back();
+            if (top.second == edges[top.first].size()) {
+                color[top.first] = 2;
+                stack.pop_back();
+                continue;
+            }
+            int next = edges[top.first][top.second++];
+            if (color[next] == 1) {
+                return true;
+            }
+            if (color[next] == 0) {
+                color[next] = 1;
+                stack.emplace_back(next, 0);
+            }
+        }
+    }
+    return false;
+}
+
+CFG GrammarTransform::eliminateLeftRecursion(const CFG &cfg) {
+
+    IndexedGrammar grammar(cfg);
+    StringSet used(grammar.symbols.begin(), grammar.symbols.end());
+
+    // Order the variables: A_1, ..., A_n (the start symbol first)
+    std::vector<std::string> order{cfg.getStartSymbol()};
+    for (int variable = 0; variable < grammar.variable_count; variable++) {
+        if (variable != grammar.start) {
+            order.push_back(grammar.symbols[variable]);
+        }
+    }
+
+    std::map<std::string, std::vector<Body>> productions;
+    for (const auto &rule: cfg.getProductionRules()) {
+        for (const auto &body: rule.second) {
+            productions[rule.first].push_back(splitBody(body));
+        }
+    }
+
+    for (std::size_t i = 0; i < order.size(); i++) {
+        const std::string &head = order[i];
+
+        // Substitute A_i -> A_j y with j < i by the bodies of A_j
+        for (std::size_t j = 0; j < i; j++) {
+            std::vector<Body> substituted;
+            for (const auto &body: productions[head]) {
+                if (body.empty() || body.front() != order[j]) {
+                    substituted.push_back(body);
+                    continue;
+                }
+                for (const auto &replacement: productions[order[j]]) {
+                    Body new_body = replacement;
+                    new_body.insert(new_body.end(), body.begin() + 1, body.end());
+                    substituted.push_back(std::move(new_body));
+                }
+            }
+            productions[head] = std::move(substituted);
+        }
+
+        // Remove the direct left recursion A -> A a | b
+        std::vector<Body> recursive;
+        std::vector<Body> others;
+        for (const auto &body: productions[head]) {
+            if (!body.empty() && body.front() == head) {
+                if (body.size() > 1) {
+                    recursive.emplace_back(body.begin() + 1, body.end());
+                }
+            } else {
+                others.push_back(body);
+            }
+        }
+        if (recursive.empty()) {
+            productions[head] = std::move(others);
+            continue;
+        }
+        std::string tail = freshVariable(head, used);
+        for (auto &body: others) {
+            body.push_back(tail);
+        }
+        for (auto &body: recursive) {
+            body.push_back(tail);
+        }
+        recursive.emplace_back();
+        productions[head] = std::move(others);
+        productions[tail] = std::move(recursive);
+    }
+
+    return buildCFG(cfg, cfg.getVariables(), productions);
+}
+
+/**
+ * Node of the trie that groups bodies on their common prefixes
+ */
+struct FactorNode {
+    std::map<std::string, FactorNode> children;
+    bool ends = false;
+};
+
+/**
+ * Recursive helper function for leftFactor: adds the bodies of a trie node as productions of head
+ * @param node the trie node, its children are the alternatives of head
+ * @param head the variable that derives the alternatives
+ * @param productions the productions of the factored CFG
+ * @param used the variable names that are in use
+ */
+void factorNode(const FactorNode &node, const std::string &head, std::map<std::string, std::vector<Body>> &productions,
+                StringSet &used) {
+    auto &bodies = productions[head];
+    if (node.ends) {
+        bodies.emplace_back();
+    }
+    for (const auto &child: node.children) {
+        // Follow the chain of nodes that have a single continuation
+        Body prefix{child.first};
+        const FactorNode *current = &child.second;
+        while (!current->ends && current->children.size() == 1) {
+            prefix.push_back(current->children.begin()->first);
+            current = &current->children.begin()->second;
+        }
+        if (current->children.empty()) {
+            productions[head].push_back(prefix);
+            continue;
+        }
+        std::string tail = freshVariable(head, used);
+        prefix.push_back(tail);
+        productions[head].push_back(prefix);
+        factorNode(*current, tail, productions, used);
+    }
+}
+
+CFG GrammarTransform::leftFactor(const CFG &cfg) {
+
+    StringSet used = cfg.getVariables();
+    used.insert(cfg.getTerminals().begin(), cfg.getTerminals().end());
+    for (const auto &rule: cfg.getProductionRules()) {
+        used.insert(rule.first);
+        for (const auto &body: rule.second) {
+            for (const auto &symbol: splitBody(body)) {
+                used.insert(symbol);
+            }
+        }
+    }
+
+    std::map<std::string, std::vector<Body>> productions;
+    for (const auto &rule: cfg.getProductionRules()) {
+        FactorNode root;
+        for (const auto &body: rule.second) {
+            FactorNode *node = &root;
+            for (const auto &symbol: splitBody(body)) {
+                node = &node->children[symbol];
+            }
+            node->ends = true;
+        }
+        factorNode(root, rule.first, productions, used);
+    }
+
+    return buildCFG(cfg, cfg.getVariables(), productions);
+}
+
+/**
+ * Hash of a flattened signature of a variable
+ */
+struct SignatureHash {
+    std::size_t operator()(const std::vector<int> &signature) const {
+        std::size_t hash = signature.size();
+        for (int value: signature) {
+            hash ^= std::hash<int>()(value) + 0x9e3779b97f4a7c15ULL + (hash << 6) + (hash >> 2);
+        }
+        return hash;
+    }
+};
+
+CFG GrammarTransform::minimize(const CFG &cfg) {
+
+    IndexedGrammar grammar(cfg);
+    const int variable_count = grammar.variable_count;
+    const int terminal_offset = variable_count;
+
+    std::vector<int> block(variable_count, 0);
+    int block_count = 1;
+
+    while (true) {
+        // The signature of a variable is its old block followed by its sorted bodies, with variables replaced
+        // by their block. Bodies are separated by -1.
+        std::unordered_map<std::vector<int>, int, SignatureHash> blocks;
+        std::vector<int> new_block(variable_count);
+        for (int variable = 0; variable < variable_count; variable++) {
+            std::vector<std::vector<int>> bodies;
+            for (int p: grammar.rules[variable]) {
+                std::vector<int> body;
+                body.reserve(grammar.bodies[p].size());
+                for (int symbol: grammar.bodies[p]) {
+                    body.push_back(grammar.isVariable(symbol) ? block[symbol] : terminal_offset + symbol);
+                }
+                bodies.push_back(std::move(body));
+            }
+            std::sort(bodies.begin(), bodies.end());
+            bodies.erase(std::unique(bodies.begin(), bodies.end()), bodies.end());
+
+            std::vector<int> signature{block[variable]};
+            for (const auto &body: bodies) {
+                signature.insert(signature.end(), body.begin(), body.end());
+                signature.push_back(-1);
+            }
+            new_block[variable] = blocks.emplace(std::move(signature), static_cast<int>(blocks.size())).first->second;
+        }
+        block = std::move(new_block);
+        if (static_cast<int>(blocks.size()) == block_count) {
+            break;
+        }
+        block_count = static_cast<int>(blocks.size());
+    }
+
+    // Every block is represented by its first variable, or by the start symbol
+    std::vector<int> representative(block_count, -1);
+    representative[block[grammar.start]] = grammar.start;
+    for (int variable = 0; variable < variable_count; variable++) {
+        if (representative[block[variable]] == -1) {
+            representative[block[variable]] = variable;
+        }
+    }
+
+    CFG result;
+    result.setStartSymbol(cfg.getStartSymbol());
+    result.setTerminals(cfg.getTerminals());
+    for (int variable = 0; variable < variable_count; variable++) {
+        if (representative[block[variable]] != variable) {
+            continue;
+        }
+        if (cfg.getVariables().find(grammar.symbols[variable]) != cfg.getVariables().end()) {
+            result.addVariable(grammar.symbols[variable]);
+        }
+        for (int p: grammar.rules[variable]) {
+            Body body;
+            for (int symbol: grammar.bodies[p]) {
+                body.push_back(grammar.symbols[grammar.isVariable(symbol) ? representative[block[symbol]] : symbol]);
+            }
+            result.addProductionRule(grammar.symbols[variable], joinBody(body));
+        }
+    }
+    return result;
+}
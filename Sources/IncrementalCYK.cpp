@@ -0,0 +1,82 @@
+//
+// Created by 2005e on 18/10/2026.
+//
+
+#include "../Headers/IncrementalCYK.h"
+
+IncrementalCYK::IncrementalCYK(const CFG &cfg) : grammar(cfg) {
+}
+
+bool IncrementalCYK::push(char symbol) {
+    const std::size_t words = grammar.words;
+    const std::size_t end = input.size() + 1;
+    input.push_back(symbol);
+    chart.resize(end * (end + 1) / 2 * words, 0);
+    auto at = [this, words](std::size_t start, std::size_t stop) {
+        return &chart[(stop * (stop - 1) / 2 + start) * words];
+    };
+
+    int terminal = grammar.tokenize(std::string(1, symbol))[0];
+    if (terminal >= 0) {
+        for (const auto &rule: grammar.terminal_rules[terminal]) {
+            setBit(at(end - 1, end), rule.head);
+        }
+    }
+    // The cells of the new column from short to long spans, cell (i, end) combines cell (i, k) of an
+    // older column with cell (k, end) of the new one
+    for (std::size_t start = end - 1; start-- > 0;) {
+        std::uint64_t *target = at(start, end);
+        for (std::size_t split = start + 1; split < end; split++) {
+            const std::uint64_t *right = at(split, end);
+            forEachBit(at(start, split), grammar.words, [&](int left) {
+                for (int index: grammar.rules_by_left[left]) {
+                    const auto &rule = grammar.binary_rules[index];
+                    if (testBit(right, rule.right)) {
+                        setBit(target, rule.head);
+                    }
+                }
+            });
+        }
+    }
+    return accepts();
+}
+
+bool IncrementalCYK::push(const std::string &symbols) {
+    for (char symbol: symbols) {
+        push(symbol);
+    }
+    return accepts();
+}
+
+void IncrementalCYK::pop() {
+    if (input.empty()) {
+        throw (std::runtime_error("IncrementalCYK error::cannot pop from an empty input"));
+    }
+    input.pop_back();
+    std::size_t end = input.size();
+    chart.resize(end * (end + 1) / 2 * grammar.words);
+}
+
+void IncrementalCYK::clear() {
+    input.clear();
+    chart.clear();
+}
+
+bool IncrementalCYK::accepts() const {
+    if (input.empty()) {
+        return grammar.accepts_empty;
+    }
+    return testBit(cell(0, input.size()), grammar.start);
+}
+
+const std::string &IncrementalCYK::getInput() const {
+    return input;
+}
+
+const std::uint64_t *IncrementalCYK::cell(std::size_t start, std::size_t end) const {
+    return &chart[(end * (end - 1) / 2 + start) * grammar.words];
+}
+
+const CNFGrammar &IncrementalCYK::getGrammar() const {
+    return grammar;
+}
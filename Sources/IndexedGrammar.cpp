@@ -0,0 +1,93 @@
+//
+// Created by 2005e on 18/10/2026.
+//
+
+#include "../Headers/IndexedGrammar.h"
+
+IndexedGrammar::IndexedGrammar(const CFG &cfg) {
+
+    const auto &production_rules = cfg.getProductionRules();
+    auto add = [this](const std::string &symbol) {
+        if (ids.find(symbol) == ids.end()) {
+            ids[symbol] = static_cast<int>(symbols.size());
+            symbols.push_back(symbol);
+        }
+    };
+
+    // Variables first
+    for (const auto &variable: cfg.getVariables()) {
+        add(variable);
+    }
+    for (const auto &rule: production_rules) {
+        add(rule.first);
+    }
+    add(cfg.getStartSymbol());
+    variable_count = static_cast<int>(symbols.size());
+    start = ids[cfg.getStartSymbol()];
+
+    // Then the terminals, also the ones that only appear in a body
+    for (const auto &terminal: cfg.getTerminals()) {
+        add(terminal);
+    }
+    for (const auto &rule: production_rules) {
+        for (const auto &body: rule.second) {
+            std::istringstream iss(body);
+            std::string symbol;
+            while (iss >> symbol) {
+                add(symbol);
+            }
+        }
+    }
+
+    rules.resize(variable_count);
+    for (const auto &rule: production_rules) {
+        int head = ids[rule.first];
+        for (const auto &body: rule.second) {
+            std::vector<int> body_ids;
+            std::istringstream iss(body);
+            std::string symbol;
+            while (iss >> symbol) {
+                body_ids.push_back(ids[symbol]);
+            }
+            rules[head].push_back(static_cast<int>(heads.size()));
+            heads.push_back(head);
+            bodies.push_back(std::move(body_ids));
+            probabilities.push_back(cfg.getProbability(rule.first, body));
+        }
+    }
+
+    char_terminals.fill(-1);
+    for (int symbol = variable_count; symbol < static_cast<int>(symbols.size()); symbol++) {
+        if (symbols[symbol].size() == 1) {
+            char_terminals[static_cast<unsigned char>(symbols[symbol][0])] = symbol;
+        }
+    }
+}
+
+std::vector<int> IndexedGrammar::tokenize(const std::string &input) const {
+    std::vector<int> tokens;
+    tokens.reserve(input.size());
+    for (char c: input) {
+        tokens.push_back(char_terminals[static_cast<unsigned char>(c)]);
+    }
+    return tokens;
+}
+
+std::string IndexedGrammar::bodyString(int production) const {
+    std::string body;
+    for (int symbol: bodies[production]) {
+        if (!body.empty()) {
+            body += " ";
+        }
+        body += symbols[symbol];
+    }
+    return body;
+}
+
+std::size_t IndexedGrammar::size() const {
+    std::size_t size = heads.size();
+    for (const auto &body: bodies) {
+        size += body.size();
+    }
+    return size;
+}
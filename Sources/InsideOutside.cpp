@@ -0,0 +1,216 @@
+//
+// Created by 2005e on 18/10/2026.
+//
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <thread>
+
+#include "../Headers/InsideOutside.h"
+
+InsideOutside::InsideOutside(const CFG &cfg) : grammar(cfg), probabilities(grammar.grammar.probabilities) {
+    const IndexedGrammar &indexed = grammar.grammar;
+    for (const auto &productions: indexed.rules) {
+        double total = 0.0;
+        for (int production: productions) {
+            total += probabilities[production];
+        }
+        for (int production: productions) {
+            probabilities[production] = total > 0.0 ? probabilities[production] / total : 0.0;
+        }
+    }
+}
+
+double InsideOutside::expectedCounts(const SemiringCYK<InsideSemiring> &cyk, const std::vector<int> &tokens,
+                                     std::vector<double> &counts) const {
+    const IndexedGrammar &indexed = grammar.grammar;
+    const std::size_t n = tokens.size();
+    const std::size_t variables = grammar.variable_count;
+
+    if (n == 0) {
+        double total = 0.0;
+        for (int production: indexed.rules[grammar.start]) {
+            if (indexed.bodies[production].empty()) {
+                total += probabilities[production];
+            }
+        }
+        if (total <= 0.0) {
+            return -std::numeric_limits<double>::infinity();
+        }
+        for (int production: indexed.rules[grammar.start]) {
+            if (indexed.bodies[production].empty()) {
+                counts[production] += probabilities[production] / total;
+            }
+        }
+        return std::log(total);
+    }
+
+    // Inside and outside charts share the flat layout of SemiringCYK
+    std::vector<double> inside = cyk.inside(tokens);
+    double total = inside[cyk.index(0, n, n, grammar.start)];
+    if (total <= 0.0) {
+        return -std::numeric_limits<double>::infinity();
+    }
+    std::vector<double> outside(inside.size(), 0.0);
+    outside[cyk.index(0, n, n, grammar.start)] = 1.0;
+
+    for (std::size_t length = n; length >= 2; length--) {
+        for (std::size_t i = 0; i + length <= n; i++) {
+            const double *parent = &outside[cyk.index(i, length, n, 0)];
+            for (std::size_t split = 1; split < length; split++) {
+                std::size_t left_index = cyk.index(i, split, n, 0);
+                std::size_t right_index = cyk.index(i + split, length - split, n, 0);
+                const double *left_inside = &inside[left_index];
+                const double *right_inside = &inside[right_index];
+                double *left_outside = &outside[left_index];
+                double *right_outside = &outside[right_index];
+                for (std::size_t variable = 0; variable < variables; variable++) {
+                    if (left_inside[variable] == 0.0) {
+                        continue;
+                    }
+                    for (int r: grammar.rules_by_left[variable]) {
+                        const auto &rule = grammar.binary_rules[r];
+                        double above = parent[rule.head] * probabilities[rule.production];
+                        if (above == 0.0 || right_inside[rule.right] == 0.0) {
+                            continue;
+                        }
+                        left_outside[variable] += above * right_inside[rule.right];
+                        right_outside[rule.right] += above * left_inside[variable];
+                        counts[rule.production] += above * left_inside[variable] * right_inside[rule.right] / total;
+                    }
+                }
+            }
+        }
+    }
+    for (std::size_t i = 0; i < n; i++) {
+        const double *cell = &outside[cyk.index(i, 1, n, 0)];
+        for (const auto &rule: grammar.terminal_rules[tokens[i]]) {
+            counts[rule.production] += cell[rule.head] * probabilities[rule.production] / total;
+        }
+    }
+    return std::log(total);
+}
+
+std::vector<double> InsideOutside::train(const std::vector<std::string> &corpus, unsigned int iterations,
+                                         unsigned int thread_count) {
+    // Whether the grammar accepts a string does not depend on the probabilities, so rejected strings are
+    // dropped once instead of every iteration
+    const SemiringCYK<BooleanSemiring> recognizer(grammar);
+    std::vector<std::vector<int>> sentences;
+    rejected = 0;
+    underflows.clear();
+    for (const auto &input: corpus) {
+        std::vector<int> tokens = grammar.tokenize(input);
+        bool accepted = std::find(tokens.begin(), tokens.end(), -1) == tokens.end();
+        if (accepted) {
+            accepted = tokens.empty() ? grammar.accepts_empty : recognizer.inside(tokens)[recognizer.index(
+                    0, tokens.size(), tokens.size(), grammar.start)] != BooleanSemiring::zero();
+        }
+        if (accepted) {
+            sentences.push_back(std::move(tokens));
+        } else {
+            rejected++;
+        }
+    }
+    if (thread_count == 0) {
+        thread_count = 1;
+    }
+    thread_count = std::min<std::size_t>(thread_count, std::max<std::size_t>(sentences.size(), 1));
+
+    const IndexedGrammar &indexed = grammar.grammar;
+    const std::size_t production_count = probabilities.size();
+    std::vector<double> log_likelihoods;
+    for (unsigned int iteration = 0; iteration < iterations; iteration++) {
+
+        // The rule weights of this iteration, shared read-only by the workers
+        const SemiringCYK<InsideSemiring> cyk(grammar, probabilities);
+
+        // Each worker sums the counts of its own slice of the corpus, the slices are added afterwards
+        std::vector<std::vector<double>> counts(thread_count, std::vector<double>(production_count, 0.0));
+        std::vector<double> likelihoods(thread_count, 0.0);
+        std::vector<std::size_t> skipped(thread_count, 0);
+        auto work = [&](unsigned int chunk) {
+            std::size_t begin = sentences.size() * chunk / thread_count;
+            std::size_t end = sentences.size() * (chunk + 1) / thread_count;
+            for (std::size_t s = begin; s < end; s++) {
+                double likelihood = expectedCounts(cyk, sentences[s], counts[chunk]);
+                if (likelihood > -std::numeric_limits<double>::infinity()) {
+                    likelihoods[chunk] += likelihood;
+                } else {
+                    skipped[chunk]++;
+                }
+            }
+        };
+        if (thread_count == 1) {
+            work(0);
+        } else {
+            std::vector<std::thread> workers;
+            for (unsigned int chunk = 0; chunk < thread_count; chunk++) {
+                workers.emplace_back(work, chunk);
+            }
+            for (auto &worker: workers) {
+                worker.join();
+            }
+        }
+        for (unsigned int chunk = 1; chunk < thread_count; chunk++) {
+            for (std::size_t p = 0; p < production_count; p++) {
+                counts[0][p] += counts[chunk][p];
+            }
+            likelihoods[0] += likelihoods[chunk];
+            skipped[0] += skipped[chunk];
+        }
+        log_likelihoods.push_back(likelihoods[0]);
+        underflows.push_back(skipped[0]);
+
+        // A head that was never used keeps its probabilities
+        for (const auto &productions: indexed.rules) {
+            double total = 0.0;
+            for (int production: productions) {
+                total += counts[0][production];
+            }
+            if (total > 0.0) {
+                for (int production: productions) {
+                    probabilities[production] = counts[0][production] / total;
+                }
+            }
+        }
+    }
+    return log_likelihoods;
+}
+
+const std::vector<double> &InsideOutside::getProbabilities() const {
+    return probabilities;
+}
+
+std::size_t InsideOutside::getRejectedCount() const {
+    return rejected;
+}
+
+const std::vector<std::size_t> &InsideOutside::getUnderflowCounts() const {
+    return underflows;
+}
+
+CFG InsideOutside::toCFG() const {
+    const IndexedGrammar &indexed = grammar.grammar;
+    CFG cfg;
+    StringSet terminals;
+    for (int symbol = 0; symbol < static_cast<int>(indexed.symbols.size()); symbol++) {
+        if (indexed.isVariable(symbol)) {
+            cfg.addVariable(indexed.symbols[symbol]);
+        } else {
+            terminals.insert(indexed.symbols[symbol]);
+        }
+    }
+    cfg.setTerminals(terminals);
+    cfg.setStartSymbol(indexed.symbols[grammar.start]);
+    for (std::size_t p = 0; p < probabilities.size(); p++) {
+        cfg.addProductionRule(indexed.symbols[indexed.heads[p]], indexed.bodyString(static_cast<int>(p)),
+                              probabilities[p]);
+    }
+    return cfg;
+}
+
+void InsideOutside::save(const std::string &filename) const {
+    toCFG().save(filename);
+}
@@ -4,6 +4,9 @@
 
 #include "../Headers/Logger.h"
 #include "../Headers/CFG.h"
+#include "../Headers/GrammarCleanup.h"
+#include "../Headers/Recognizer.h"
+#include "../Headers/PreFilter.h"
 
 void Logger::printTable(ParseTable &table) {
     std::vector<int> table_sizes;
@@ -140,6 +143,33 @@ void Logger::printProductions(const std::map<std::string, StringSet> &production
     std::cout << "}" << std::endl;
 }
 
+void Logger::printCleanupReport(const CleanupReport &report) {
+    std::cout << ">>> Cleanup" << std::endl;
+    std::cout << " >> Variables:   " << report.variables_before << " -> " << report.variables_after << std::endl;
+    std::cout << " >> Productions: " << report.productions_before << " -> " << report.productions_after << std::endl;
+    std::cout << " >> Size:        " << report.size_before << " -> " << report.size_after << std::endl;
+    std::cout << " >> Nullable:    " << setToString(report.nullable) << std::endl;
+    std::cout << " >> Removed:     " << setToString(report.removed) << std::endl;
+}
+
+void Logger::printRecognizer(const Recognizer &recognizer) {
+    std::cout << ">>> Recognizer" << std::endl;
+    std::cout << " >> Engine: " << recognizer.getEngineName() << std::endl;
+    std::cout << " >> Reason: " << recognizer.getReason() << std::endl;
+    if (auto prefilter = recognizer.getPreFilter()) {
+        printPreFilter(*prefilter);
+    }
+}
+
+void Logger::printPreFilter(const PreFilter &prefilter) {
+    std::cout << ">>> Pre-filter" << std::endl;
+    std::cout << " >> Checked: " << prefilter.getChecked() << std::endl;
+    for (int filter = 0; filter < PreFilter::filter_count; filter++) {
+        auto kind = static_cast<PreFilter::Filter>(filter);
+        std::cout << " >> Rejected by " << PreFilter::filterName(kind) << ": " << prefilter.getFired(kind) << std::endl;
+    }
+}
+
 void Logger::printJSON(const ParseTable &table) {
     json j;
     j["first"] = table.firstSet;
@@ -0,0 +1,118 @@
+//
+// Created by 2005e on 18/10/2026.
+//
+
+#include "../Headers/MembershipCache.h"
+
+namespace {
+
+    /**
+     * The splitmix64 finalizer, spreads the bits of a hash over the whole word
+     */
+    std::uint64_t mix(std::uint64_t x) {
+        x ^= x >> 30;
+        x *= 0xbf58476d1ce4e5b9ULL;
+        x ^= x >> 27;
+        x *= 0x94d049bb133111ebULL;
+        x ^= x >> 31;
+        return x;
+    }
+
+}
+
+MembershipCache::MembershipCache(std::size_t capacity, std::size_t shard_count) : shards(shard_count) {
+    if (capacity == 0 || shard_count == 0) {
+        throw (std::runtime_error("MembershipCache error::the capacity and the number of shards have to be positive"));
+    }
+    shard_capacity = (capacity + shard_count - 1) / shard_count;
+}
+
+std::uint64_t MembershipCache::fingerprint(const CFG &cfg) {
+    // Separators that cannot occur inside a symbol keep different grammars from serializing the same way
+    std::string text = cfg.getStartSymbol() + '\x01';
+    for (const auto &terminal: cfg.getTerminals()) {
+        text += terminal + '\x02';
+    }
+    for (const auto &[head, bodies]: cfg.getProductionRules()) {
+        text += head + '\x01';
+        for (const auto &body: bodies) {
+            text += body + '\x02';
+        }
+    }
+    return mix(std::hash<std::string>{}(text));
+}
+
+std::uint64_t MembershipCache::key(std::uint64_t fingerprint, const std::string &input) {
+    return mix(std::hash<std::string>{}(input) ^ fingerprint);
+}
+
+MembershipCache::Shard &MembershipCache::shard(std::uint64_t key) {
+    // The high bits pick the shard, the map of the shard hashes the whole key
+    return shards[(key >> 32) % shards.size()];
+}
+
+std::optional<bool> MembershipCache::lookup(std::uint64_t fingerprint, const std::string &input) {
+    std::uint64_t k = key(fingerprint, input);
+    Shard &s = shard(k);
+    {
+        std::lock_guard<std::mutex> lock(s.mutex);
+        auto it = s.index.find(k);
+        // A colliding key stores another input, which is a miss
+        if (it != s.index.end() && it->second->fingerprint == fingerprint && it->second->input == input) {
+            s.entries.splice(s.entries.begin(), s.entries, it->second);
+            hits.fetch_add(1, std::memory_order_relaxed);
+            return it->second->accepted;
+        }
+    }
+    misses.fetch_add(1, std::memory_order_relaxed);
+    return std::nullopt;
+}
+
+void MembershipCache::insert(std::uint64_t fingerprint, const std::string &input, bool accepted) {
+    std::uint64_t k = key(fingerprint, input);
+    Shard &s = shard(k);
+    std::lock_guard<std::mutex> lock(s.mutex);
+    auto it = s.index.find(k);
+    if (it != s.index.end()) {
+        *it->second = {k, fingerprint, input, accepted};
+        s.entries.splice(s.entries.begin(), s.entries, it->second);
+        return;
+    }
+    if (s.entries.size() == shard_capacity) {
+        s.index.erase(s.entries.back().key);
+        s.entries.pop_back();
+    }
+    s.entries.push_front({k, fingerprint, input, accepted});
+    s.index[k] = s.entries.begin();
+}
+
+void MembershipCache::clear() {
+    for (auto &s: shards) {
+        std::lock_guard<std::mutex> lock(s.mutex);
+        s.entries.clear();
+        s.index.clear();
+    }
+    hits.store(0, std::memory_order_relaxed);
+    misses.store(0, std::memory_order_relaxed);
+}
+
+std::size_t MembershipCache::size() {
+    std::size_t total = 0;
+    for (auto &s: shards) {
+        std::lock_guard<std::mutex> lock(s.mutex);
+        total += s.entries.size();
+    }
+    return total;
+}
+
+std::size_t MembershipCache::getCapacity() const {
+    return shard_capacity * shards.size();
+}
+
+std::size_t MembershipCache::getHits() const {
+    return hits.load(std::memory_order_relaxed);
+}
+
+std::size_t MembershipCache::getMisses() const {
+    return misses.load(std::memory_order_relaxed);
+}
@@ -4,6 +4,11 @@
 
 #include "../Headers/PDA.h"
 
+#include <cmath>
+#include <thread>
+#include <unordered_map>
+#include <unordered_set>
+
 PDA::PDA() {}
 
 PDA::PDA(const std::string &filename) {
@@ -31,33 +36,266 @@ PDA::PDA(const std::string &filename) {
     }
 }
 
+std::uint64_t TripleTable::addState(const std::string &state) {
+    auto it = state_ids.find(state);
+    if (it != state_ids.end()) {
+        return it->second;
+    }
+    names.clear();
+    state_names.push_back(state);
+    return state_ids[state] = state_names.size() - 1;
+}
+
+std::uint64_t TripleTable::addSymbol(const std::string &symbol) {
+    auto it = symbol_ids.find(symbol);
+    if (it != symbol_ids.end()) {
+        return it->second;
+    }
+    names.clear();
+    symbol_names.push_back(symbol);
+    return symbol_ids[symbol] = symbol_names.size() - 1;
+}
+
+std::uint64_t TripleTable::getState(const std::string &state) const {
+    return state_ids.at(state);
+}
+
+std::uint64_t TripleTable::getSymbol(const std::string &symbol) const {
+    return symbol_ids.at(symbol);
+}
+
+const std::string &TripleTable::name(std::uint64_t triple) {
+    if (names.empty()) {
+        names.resize(state_names.size() * symbol_names.size() * state_names.size());
+    }
+    std::string &name = names[triple];
+    if (name.empty()) {
+        std::uint64_t p = triple % state_names.size();
+        std::uint64_t X = (triple / state_names.size()) % symbol_names.size();
+        std::uint64_t q = triple / state_names.size() / symbol_names.size();
+        name.reserve(state_names[q].size() + symbol_names[X].size() + state_names[p].size() + 4);
+        name += "[";
+        name += state_names[q];
+        name += ",";
+        name += symbol_names[X];
+        name += ",";
+        name += state_names[p];
+        name += "]";
+    }
+    return name;
+}
+
 /**
- * Recursive helper function for toCFG
- * @return a production rule body as a string
+ * Generates all production rules that belong to a single transition of the PDA
+ * @param transition the transition (from state, input, stacktop) and one of its targets
+ * @param move the index of the move, stored with every production to recover the input symbol
+ * @param productions the buffer the generated production rules are appended to
+ * @param table the interned states and stack symbols
+ * @param state_count the number of states the variables range over
+ * @param usable if not null, usable[state][symbol] tells if (state, symbol) has moves,
+ * bodies with a variable [state,symbol,p] that is not usable are skipped (pruned mode)
  */
-void generateBody(int iterations, const std::string &head, std::string body, CFG &cfg, const std::string &state,
-                  const std::string &final_state, const std::vector<std::string> &replacement, int index,
-                  const StringSet &states) {
-    if (iterations == 0) {
-        if (!body.empty()) {
-            body += " ";
-        }
-        body += "[" + state + "," + replacement.back() + "," + final_state + "]";
-        cfg.addProductionRule(head, body);
-    } else {
-        const std::string &current_symbol = replacement[index];
-        for (const auto &new_state: states) {
-            std::string new_body = body;
-            if (!body.empty()) {
-                new_body += " ";
+void generateProductions(const TransitionMove &transition, std::uint64_t move, ProductionBuffer &productions,
+                         const TripleTable &table, std::uint64_t state_count,
+                         const std::vector<std::vector<bool>> *usable) {
+    std::uint64_t q = table.getState(std::get<0>(*transition.first));
+    std::uint64_t X = table.getSymbol(std::get<2>(*transition.first));
+    std::uint64_t next_state = table.getState(transition.second->first);
+    const auto &replacement = transition.second->second;
+
+    if (replacement.empty()) {
+        // Case 1: Geen vervangingen
+        productions.insert(productions.end(), {table.pack(q, X, next_state), move, 0});
+        return;
+    }
+
+    // Case 2: Vervangingen zijn aanwezig
+    // Every body needs a state after each replacement symbol, without states there are no bodies at all
+    if (state_count == 0) {
+        return;
+    }
+    std::vector<std::uint64_t> symbols;
+    for (const auto &symbol: replacement) {
+        symbols.push_back(table.getSymbol(symbol));
+    }
+    std::size_t k = symbols.size();
+    if (usable && !(*usable)[next_state][symbols[0]]) {
+        return;
+    }
+    // choices[i] are the states that may appear between the i-th and (i+1)-th replacement symbol,
+    // the last position is the final state of the head
+    std::vector<std::vector<std::uint64_t>> choices(k);
+    for (std::size_t i = 0; i < k; i++) {
+        for (std::uint64_t state = 0; state < state_count; state++) {
+            if (!usable || i + 1 == k || (*usable)[state][symbols[i + 1]]) {
+                choices[i].push_back(state);
+            }
+        }
+        if (choices[i].empty()) {
+            return;
+        }
+    }
+
+    std::vector<std::size_t> between(k, 0);
+    while (true) {
+        productions.insert(productions.end(), {table.pack(q, X, choices[k - 1][between[k - 1]]), move, k});
+        std::uint64_t state = next_state;
+        for (std::size_t i = 0; i < k; i++) {
+            std::uint64_t next = choices[i][between[i]];
+            productions.push_back(table.pack(state, symbols[i], next));
+            state = next;
+        }
+        // Advance to the next combination of states
+        std::size_t position = k;
+        while (position > 0 && ++between[position - 1] == choices[position - 1].size()) {
+            between[position - 1] = 0;
+            position--;
+        }
+        if (position == 0) {
+            break;
+        }
+    }
+}
+
+/**
+ * Multiplies two counts, saturating at the maximum value instead of overflowing
+ */
+std::size_t saturatingMultiply(std::size_t a, std::size_t b) {
+    std::size_t result;
+    if (__builtin_mul_overflow(a, b, &result)) {
+        return static_cast<std::size_t>(-1);
+    }
+    return result;
+}
+
+/**
+ * Adds two counts, saturating at the maximum value instead of overflowing
+ */
+std::size_t saturatingAdd(std::size_t a, std::size_t b) {
+    std::size_t result;
+    if (__builtin_add_overflow(a, b, &result)) {
+        return static_cast<std::size_t>(-1);
+    }
+    return result;
+}
+
+ConversionEstimate PDA::estimateCFGSize() const {
+
+    // Rough memory cost of a string stored in a set or map node of the CFG
+    const std::size_t node_size = sizeof(std::string) + 4 * sizeof(void *);
+
+    std::size_t state_count = states.size();
+    std::size_t state_lengths = 0;
+    for (const auto &state: states) {
+        state_lengths += state.size();
+    }
+    // (state, stack symbol) pairs that have moves and the number of such declared states per stack symbol
+    std::set<std::pair<std::string, std::string>> usable;
+    for (const auto &transition: transitions) {
+        usable.emplace(std::get<0>(transition.first), std::get<2>(transition.first));
+    }
+    std::map<std::string, std::size_t> usable_states;
+    for (const auto &pair: usable) {
+        if (states.find(pair.first) != states.end()) {
+            usable_states[pair.second]++;
+        }
+    }
+
+    ConversionEstimate estimate;
+    estimate.variables = saturatingAdd(saturatingMultiply(saturatingMultiply(state_count, state_count),
+                                                          stack_alphabet.size()), 1);
+    estimate.productions = state_count;
+    estimate.pruned_productions = state_count;
+
+    std::size_t variable_chars = 0;
+    for (const auto &symbol: stack_alphabet) {
+        variable_chars = saturatingAdd(variable_chars, saturatingMultiply(state_count * state_count,
+                                                                          symbol.size() + 4) + 2 * state_count *
+                                                                                               state_lengths);
+    }
+    std::size_t body_chars = saturatingMultiply(state_count, start_state.size() + start_symbol.size() + 4) +
+                             state_lengths;
+    std::size_t pruned_body_chars = body_chars;
+
+    for (const auto &transition: transitions) {
+        const std::string &input = std::get<1>(transition.first);
+        for (const auto &next: transition.second) {
+            std::size_t k = next.second.size();
+            if (k == 0) {
+                estimate.productions = saturatingAdd(estimate.productions, 1);
+                estimate.pruned_productions = saturatingAdd(estimate.pruned_productions, 1);
+                body_chars = saturatingAdd(body_chars, input.size());
+                pruned_body_chars = saturatingAdd(pruned_body_chars, input.size());
+                continue;
+            }
+            // |Q|^k bodies: one free state between each pair of replacement symbols and one final state
+            std::size_t count = 1;
+            for (std::size_t i = 0; i < k; i++) {
+                count = saturatingMultiply(count, state_count);
+            }
+            // Every body has k variables of the form [s,Y,t], k - 1 separating spaces and the input symbol
+            std::size_t length = (input.empty() ? 0 : input.size() + 1) + k - 1;
+            for (std::size_t i = 0; i < k; i++) {
+                length += next.second[i].size() + 4;
+            }
+            // The free states contribute their average length twice (as end of one variable and start of the next)
+            std::size_t chars = saturatingMultiply(count, length + next.first.size());
+            if (state_count != 0) {
+                chars = saturatingAdd(chars, saturatingMultiply(count / state_count, (2 * k - 1) * state_lengths));
             }
-            new_body += "[" + state + "," + current_symbol + "," + new_state + "]"; // NOLINT
-            generateBody(iterations - 1, head, new_body, cfg, new_state, final_state, replacement, index + 1, states);
+
+            // In pruned mode the state in front of every replacement symbol needs moves for that symbol
+            std::size_t pruned = usable.count({next.first, next.second[0]}) ? state_count : 0;
+            for (std::size_t i = 1; i < k; i++) {
+                auto it = usable_states.find(next.second[i]);
+                pruned = saturatingMultiply(pruned, it == usable_states.end() ? 0 : it->second);
+            }
+
+            estimate.productions = saturatingAdd(estimate.productions, count);
+            estimate.pruned_productions = saturatingAdd(estimate.pruned_productions, pruned);
+            body_chars = saturatingAdd(body_chars, chars);
+            pruned_body_chars = saturatingAdd(pruned_body_chars, count == 0 ? 0 : saturatingMultiply(
+                    chars / count, pruned));
         }
     }
+
+    estimate.bytes = saturatingAdd(saturatingAdd(saturatingMultiply(estimate.productions, node_size), body_chars),
+                                   saturatingAdd(saturatingMultiply(estimate.variables, 2 * node_size),
+                                                 2 * variable_chars));
+    estimate.pruned_bytes = saturatingAdd(saturatingAdd(saturatingMultiply(estimate.pruned_productions, node_size),
+                                                        pruned_body_chars),
+                                          saturatingAdd(saturatingMultiply(estimate.variables, 2 * node_size),
+                                                        2 * variable_chars));
+    return estimate;
+}
+
+CFG PDA::toCFG() const {
+    return toCFG(1);
 }
 
-CFG PDA::toCFG() {
+CFG PDA::toCFG(unsigned int thread_count) const {
+    return toCFG(thread_count, ConversionBudget());
+}
+
+CFG PDA::toCFG(unsigned int thread_count, const ConversionBudget &budget) const {
+
+    // Check the size of the result before anything is allocated
+    bool pruned = false;
+    if (budget.max_productions != 0 || budget.max_bytes != 0) {
+        ConversionEstimate estimate = estimateCFGSize();
+        auto exceeds = [&budget](std::size_t productions, std::size_t bytes) {
+            return (budget.max_productions != 0 && productions > budget.max_productions) ||
+                   (budget.max_bytes != 0 && bytes > budget.max_bytes);
+        };
+        if (exceeds(estimate.productions, estimate.bytes)) {
+            if (!budget.prune || exceeds(estimate.pruned_productions, estimate.pruned_bytes)) {
+                throw (std::runtime_error(
+                        "PDA error::toCFG would generate " + std::to_string(estimate.productions) +
+                        " productions (about " + std::to_string(estimate.bytes) + " bytes), which exceeds the budget"));
+            }
+            pruned = true;
+        }
+    }
 
     CFG cfg;
     // Set StartState
@@ -66,33 +304,398 @@ CFG PDA::toCFG() {
     cfg.setTerminals(input_alphabet);
     // Set the Variables
     cfg.addVariable("S");
-    for (const auto &state1: states)
-        for (const auto &state2: states)
-            for (const auto &alphabet_symbol: stack_alphabet)
-                cfg.addVariable("[" + state1 + "," + alphabet_symbol + "," + state2 + "]"); // NOLINT
-    // Add the production rules
+
+    // Intern the states and stack symbols, the declared ones come first
+    TripleTable table;
     for (const auto &state: states) {
-        cfg.addProductionRule("S", "[" + start_state + "," + start_symbol + "," + state + "]");
+        table.addState(state);
+    }
+    for (const auto &symbol: stack_alphabet) {
+        table.addSymbol(symbol);
+    }
+    table.addState(start_state);
+    table.addSymbol(start_symbol);
+    for (const auto &transition: transitions) {
+        table.addState(std::get<0>(transition.first));
+        table.addSymbol(std::get<2>(transition.first));
+        for (const auto &next: transition.second) {
+            table.addState(next.first);
+            for (const auto &symbol: next.second) {
+                table.addSymbol(symbol);
+            }
+        }
+    }
+    const std::uint64_t state_count = states.size();
+    const std::uint64_t symbol_count = stack_alphabet.size();
+
+    // In pruned mode only variables [q,X,p] where (q, X) has moves are used in bodies. The table also holds the
+    // states that only appear in transitions, those can be the target of a move too
+    std::vector<std::vector<bool>> usable;
+    if (pruned) {
+        usable.assign(table.stateCount(), std::vector<bool>(table.symbolCount(), false));
+        for (const auto &transition: transitions) {
+            usable[table.getState(std::get<0>(transition.first))][table.getSymbol(std::get<2>(transition.first))] = true;
+        }
+    }
+
+    for (std::uint64_t state1 = 0; state1 < state_count; state1++)
+        for (std::uint64_t state2 = 0; state2 < state_count; state2++)
+            for (std::uint64_t symbol = 0; symbol < symbol_count; symbol++)
+                cfg.addVariable(table.name(table.pack(state1, symbol, state2)));
+    // Add the production rules
+    for (std::uint64_t state = 0; state < state_count; state++) {
+        cfg.addProductionRule("S", table.name(table.pack(table.getState(start_state), table.getSymbol(start_symbol),
+                                                         state)));
     }
 
+    // Every (transition, target) pair is converted independently, weighted by the |Q|^k bodies it produces
+    std::vector<TransitionMove> moves;
+    std::vector<double> weights;
     for (const auto &transition: transitions) {
         for (const auto &next: transition.second) {
-            std::string q = std::get<0>(transition.first);
-            std::string a = std::get<1>(transition.first);
-            std::string X = std::get<2>(transition.first);
-            if (next.second.empty()) {
-                // Case 1: Geen vervangingen
-                cfg.addProductionRule("[" + q + "," + X + "," + next.first + "]", a); // NOLINT
-            } else {
-                // Case 2: Vervangingen zijn aanwezig
-                for (const auto &state: states) {
-                    std::string head = "[" + q + "," + X + "," + state + ']'; // NOLINT
-                    generateBody(next.second.size() - 1, head, a, cfg, next.first, state, next.second, 0, states);
+            moves.emplace_back(&transition.first, &next);
+            weights.push_back(next.second.empty() ? 1.0 : std::pow(static_cast<double>(states.size()),
+                                                                     static_cast<double>(next.second.size())));
+        }
+    }
+
+    if (thread_count == 0) {
+        thread_count = 1;
+    }
+    thread_count = std::min<std::size_t>(thread_count, std::max<std::size_t>(moves.size(), 1));
+
+    // Split the moves in contiguous chunks of roughly equal weight
+    double total_weight = 0;
+    for (double weight: weights) {
+        total_weight += weight;
+    }
+    std::vector<std::size_t> bounds{0};
+    double accumulated = 0;
+    for (std::size_t i = 0; i < moves.size() && bounds.size() < thread_count; i++) {
+        accumulated += weights[i];
+        if (accumulated >= total_weight * static_cast<double>(bounds.size()) / thread_count) {
+            bounds.push_back(i + 1);
+        }
+    }
+    while (bounds.size() <= thread_count) {
+        bounds.push_back(moves.size());
+    }
+
+    // Each worker fills its own buffer, the buffers are merged in chunk order afterwards
+    std::vector<ProductionBuffer> buffers(thread_count);
+    auto work = [&](unsigned int chunk) {
+        for (std::size_t i = bounds[chunk]; i < bounds[chunk + 1]; i++) {
+            generateProductions(moves[i], i, buffers[chunk], table, state_count, pruned ? &usable : nullptr);
+        }
+    };
+    if (thread_count == 1) {
+        work(0);
+    } else {
+        std::vector<std::thread> workers;
+        for (unsigned int chunk = 0; chunk < thread_count; chunk++) {
+            workers.emplace_back(work, chunk);
+        }
+        for (auto &worker: workers) {
+            worker.join();
+        }
+    }
+
+    // The printable names are only formatted here, when the productions are added to the CFG
+    for (auto &buffer: buffers) {
+        std::size_t i = 0;
+        while (i < buffer.size()) {
+            const std::string &head = table.name(buffer[i]);
+            std::string body = std::get<1>(*moves[buffer[i + 1]].first);
+            std::uint64_t length = buffer[i + 2];
+            i += 3;
+            for (std::uint64_t j = 0; j < length; j++, i++) {
+                if (!body.empty()) {
+                    body += " ";
                 }
+                body += table.name(buffer[i]);
             }
+            cfg.addProductionRule(head, std::move(body));
         }
+        ProductionBuffer().swap(buffer);
     }
     return cfg;
 }
 
+bool PDA::isDeterministic() const {
+    std::set<std::pair<std::string, std::string>> epsilon_moves;
+    std::set<std::pair<std::string, std::string>> input_moves;
+    for (const auto &transition: transitions) {
+        if (transition.second.size() > 1) {
+            return false;
+        }
+        auto key = std::make_pair(std::get<0>(transition.first), std::get<2>(transition.first));
+        if (std::get<1>(transition.first).empty()) {
+            epsilon_moves.insert(key);
+        } else {
+            input_moves.insert(key);
+        }
+    }
+    for (const auto &key: epsilon_moves) {
+        if (input_moves.find(key) != input_moves.end()) {
+            return false;
+        }
+    }
+    return true;
+}
+
+const StringSet &PDA::getStates() const {
+    return states;
+}
+
+const StringSet &PDA::getInputAlphabet() const {
+    return input_alphabet;
+}
+
+const StringSet &PDA::getStackAlphabet() const {
+    return stack_alphabet;
+}
+
+const std::string &PDA::getStartState() const {
+    return start_state;
+}
+
+const std::string &PDA::getStartSymbol() const {
+    return start_symbol;
+}
+
+const std::map<Transition, std::set<TransitionTarget>> &PDA::getTransitions() const {
+    return transitions;
+}
+
+/**
+ * Hash of a configuration of the PDA: the state followed by the stack
+ */
+struct ConfigurationHash {
+    std::size_t operator()(const std::vector<int> &configuration) const {
+        std::size_t hash = configuration.size();
+        for (int value: configuration) {
+            hash ^= std::hash<int>()(value) + 0x9e3779b97f4a7c15ULL + (hash << 6) + (hash >> 2);
+        }
+        return hash;
+    }
+};
+
+bool PDA::accepts(const std::string &input) const {
+    std::vector<std::string> symbols;
+    symbols.reserve(input.size());
+    for (char c: input) {
+        symbols.emplace_back(1, c);
+    }
+    return accepts(symbols);
+}
+
+bool PDA::accepts(const std::vector<std::string> &input) const {
+
+    // In a shortest accepting run no stack symbol X, pushed in state q and popped into state p over some span of
+    // the input, has a symbol above it that does the same (q, X, p) over the same span: that inner part of the run
+    // could replace the outer one. The symbols whose part of the run is in progress therefore form a chain of at
+    // most (n + 1) |Q|^2 |Γ| symbols (one per span length and triple), and each of them left at most k - 1 pushed
+    // symbols waiting on the stack, where k is the longest replacement
+    StringSet all_states = states;
+    StringSet all_symbols = stack_alphabet;
+    all_states.insert(start_state);
+    all_symbols.insert(start_symbol);
+    std::size_t longest = 0;
+    for (const auto &transition: transitions) {
+        all_states.insert(std::get<0>(transition.first));
+        all_symbols.insert(std::get<2>(transition.first));
+        for (const auto &next: transition.second) {
+            all_states.insert(next.first);
+            all_symbols.insert(next.second.begin(), next.second.end());
+            longest = std::max(longest, next.second.size());
+        }
+    }
+    std::size_t triples = saturatingMultiply(saturatingMultiply(all_states.size(), all_states.size()),
+                                             all_symbols.size());
+    std::size_t bound = saturatingAdd(saturatingMultiply(saturatingMultiply(input.size() + 1, triples),
+                                                         longest == 0 ? 0 : longest - 1), 1);
+
+    // A shortest run never needs a configuration above the bound, so a search that was cut off still rejects
+    return acceptsWithin(input, bound).value_or(false);
+}
+
+std::optional<bool> PDA::acceptsWithin(const std::string &input, std::size_t max_stack) const {
+    std::vector<std::string> symbols;
+    symbols.reserve(input.size());
+    for (char c: input) {
+        symbols.emplace_back(1, c);
+    }
+    return acceptsWithin(symbols, max_stack);
+}
+
+std::optional<bool> PDA::acceptsWithin(const std::vector<std::string> &input, std::size_t max_stack) const {
 
+    // Number the states, input symbols and stack symbols
+    std::map<std::string, int> state_ids;
+    std::map<std::string, int> symbol_ids;
+    std::map<std::string, int> input_ids{{"", 0}};
+    auto id = [](std::map<std::string, int> &ids, const std::string &name) {
+        return ids.emplace(name, static_cast<int>(ids.size())).first->second;
+    };
+
+    // (state, input, stacktop) -> (next state, pushed symbols from bottom to top)
+    std::unordered_map<long long, std::vector<std::pair<int, std::vector<int>>>> moves;
+    auto key = [](long long state, long long column, long long top) {
+        return (state << 42) | (column << 21) | top;
+    };
+    for (const auto &transition: transitions) {
+        long long from = id(state_ids, std::get<0>(transition.first));
+        long long column = id(input_ids, std::get<1>(transition.first));
+        long long top = id(symbol_ids, std::get<2>(transition.first));
+        auto &targets = moves[key(from, column, top)];
+        for (const auto &next: transition.second) {
+            std::vector<int> push;
+            for (auto it = next.second.rbegin(); it != next.second.rend(); it++) {
+                push.push_back(id(symbol_ids, *it));
+            }
+            targets.emplace_back(id(state_ids, next.first), push);
+        }
+    }
+
+    std::vector<int> columns;
+    for (const auto &symbol: input) {
+        auto it = input_ids.find(symbol);
+        if (symbol.empty() || it == input_ids.end()) {
+            return false;
+        }
+        columns.push_back(it->second);
+    }
+
+    // Lower bound on the number of input symbols needed to pop each stack symbol, used to prune configurations
+    const std::size_t unreachable = static_cast<std::size_t>(-1);
+    std::vector<std::size_t> consume(symbol_ids.size(), unreachable);
+    bool changed = true;
+    while (changed) {
+        changed = false;
+        for (const auto &move: moves) {
+            std::size_t top = move.first & ((1LL << 21) - 1);
+            std::size_t base = ((move.first >> 21) & ((1LL << 21) - 1)) != 0;
+            for (const auto &target: move.second) {
+                std::size_t cost = base;
+                for (int symbol: target.second) {
+                    cost = consume[symbol] == unreachable ? unreachable : cost + consume[symbol];
+                    if (cost == unreachable) {
+                        break;
+                    }
+                }
+                if (cost < consume[top]) {
+                    consume[top] = cost;
+                    changed = true;
+                }
+            }
+        }
+    }
+    auto feasible = [&consume, &unreachable](const std::vector<int> &configuration, std::size_t remaining) {
+        std::size_t needed = 0;
+        for (std::size_t i = 1; i < configuration.size(); i++) {
+            if (consume[configuration[i]] == unreachable) {
+                return false;
+            }
+            needed += consume[configuration[i]];
+        }
+        return needed <= remaining;
+    };
+
+    // Set when a configuration is dropped because of the stack limit, a rejection is then unknown
+    bool truncated = false;
+    auto withinLimit = [&truncated, max_stack](const std::vector<int> &configuration) {
+        if (configuration.size() - 1 > max_stack) {
+            truncated = true;
+            return false;
+        }
+        return true;
+    };
+
+    // A configuration is stored as the state followed by the stack from bottom to top
+    using Configurations = std::unordered_set<std::vector<int>, ConfigurationHash>;
+    Configurations current{{id(state_ids, start_state), id(symbol_ids, start_symbol)}};
+
+    for (std::size_t position = 0; position <= columns.size(); position++) {
+        // Epsilon closure of the configurations at this position
+        std::vector<std::vector<int>> worklist(current.begin(), current.end());
+        while (!worklist.empty()) {
+            std::vector<int> configuration = std::move(worklist.back());
+            worklist.pop_back();
+            if (configuration.size() == 1) {
+                if (position == columns.size()) {
+                    return true;
+                }
+                continue;
+            }
+            auto it = moves.find(key(configuration[0], 0, configuration.back()));
+            if (it == moves.end()) {
+                continue;
+            }
+            for (const auto &target: it->second) {
+                std::vector<int> next(configuration.begin(), configuration.end() - 1);
+                next[0] = target.first;
+                next.insert(next.end(), target.second.begin(), target.second.end());
+                if (feasible(next, columns.size() - position) && withinLimit(next) &&
+                    current.insert(next).second) {
+                    worklist.push_back(std::move(next));
+                }
+            }
+        }
+        if (position == columns.size()) {
+            break;
+        }
+
+        // Read the next input symbol
+        Configurations next_configurations;
+        for (const auto &configuration: current) {
+            if (configuration.size() == 1) {
+                continue;
+            }
+            auto it = moves.find(key(configuration[0], columns[position], configuration.back()));
+            if (it == moves.end()) {
+                continue;
+            }
+            for (const auto &target: it->second) {
+                std::vector<int> next(configuration.begin(), configuration.end() - 1);
+                next[0] = target.first;
+                next.insert(next.end(), target.second.begin(), target.second.end());
+                if (feasible(next, columns.size() - position - 1) && withinLimit(next)) {
+                    next_configurations.insert(std::move(next));
+                }
+            }
+        }
+        if (next_configurations.empty()) {
+            break;
+        }
+        current = std::move(next_configurations);
+    }
+    if (truncated) {
+        return std::nullopt;
+    }
+    return false;
+}
+
+void PDA::addState(const std::string &state) {
+    states.insert(state);
+}
+
+void PDA::setInputAlphabet(const StringSet &alphabet) {
+    input_alphabet = alphabet;
+}
+
+void PDA::setStackAlphabet(const StringSet &alphabet) {
+    stack_alphabet = alphabet;
+}
+
+void PDA::setStartState(const std::string &state) {
+    start_state = state;
+}
+
+void PDA::setStartSymbol(const std::string &symbol) {
+    start_symbol = symbol;
+}
+
+void PDA::addTransition(const std::string &from, const std::string &input, const std::string &stacktop,
+                        const std::string &to, const std::vector<std::string> &replacement) {
+    transitions[Transition(from, input, stacktop)].insert(std::make_pair(to, replacement));
+}
@@ -0,0 +1,234 @@
+//
+// Created by 2005e on 18/10/2026.
+//
+
+#include <algorithm>
+#include <limits>
+#include <unordered_map>
+
+#include "../Headers/ParseForest.h"
+
+namespace {
+    const std::uint64_t saturated = std::numeric_limits<std::uint64_t>::max();
+
+    std::uint64_t saturatingAdd(std::uint64_t a, std::uint64_t b) {
+        std::uint64_t result;
+        return __builtin_add_overflow(a, b, &result) ? saturated : result;
+    }
+
+    std::uint64_t saturatingMultiply(std::uint64_t a, std::uint64_t b) {
+        std::uint64_t result;
+        return __builtin_mul_overflow(a, b, &result) ? saturated : result;
+    }
+}
+
+std::vector<std::uint64_t> ParseForest::countAll() const {
+    // Shared nodes are referred to from several places, so count in post order
+    std::vector<std::uint64_t> counts(nodes.size(), 0);
+    std::vector<bool> done(nodes.size(), false);
+    std::vector<std::pair<int, bool>> stack;
+    if (root >= 0) {
+        stack.emplace_back(root, false);
+    }
+    while (!stack.empty()) {
+        auto [node, expanded] = stack.back();
+        stack.pop_back();
+        if (done[node]) {
+            continue;
+        }
+        const ForestNode &current = nodes[node];
+        if (!expanded) {
+            stack.emplace_back(node, true);
+            for (int c = 0; c < current.child_count; c++) {
+                if (!done[children[current.first_child + c]]) {
+                    stack.emplace_back(children[current.first_child + c], false);
+                }
+            }
+            continue;
+        }
+        std::uint64_t count;
+        if (current.packed) {
+            count = 1;
+            for (int c = 0; c < current.child_count; c++) {
+                count = saturatingMultiply(count, counts[children[current.first_child + c]]);
+            }
+        } else if (current.child_count == 0) {
+            count = 1;
+        } else {
+            count = 0;
+            for (int c = 0; c < current.child_count; c++) {
+                count = saturatingAdd(count, counts[children[current.first_child + c]]);
+            }
+        }
+        counts[node] = count;
+        done[node] = true;
+    }
+    return counts;
+}
+
+std::uint64_t ParseForest::countTrees() const {
+    if (root < 0) {
+        return 0;
+    }
+    return countAll()[root];
+}
+
+ParseTree ParseForest::tree(std::uint64_t index) const {
+    std::vector<std::uint64_t> counts = countAll();
+    if (root < 0 || index >= counts[root]) {
+        throw (std::runtime_error("ParseForest error::there is no tree with index " + std::to_string(index)));
+    }
+    ParseTree result;
+    std::vector<std::pair<int, ParseTree *>> stack{{root, &result}};
+    std::vector<std::uint64_t> indices{index};
+    while (!stack.empty()) {
+        auto [node, tree] = stack.back();
+        std::uint64_t rank = indices.back();
+        stack.pop_back();
+        indices.pop_back();
+        const ForestNode &symbol = nodes[node];
+        tree->symbol = symbols[symbol.symbol];
+
+        // Pick the packed child that contains tree number rank
+        int packed = -1;
+        for (int c = 0; c < symbol.child_count; c++) {
+            packed = children[symbol.first_child + c];
+            if (rank < counts[packed]) {
+                break;
+            }
+            rank -= counts[packed];
+        }
+        if (packed < 0) {
+            continue;
+        }
+        const ForestNode &back_pointer = nodes[packed];
+        tree->children.resize(back_pointer.child_count);
+        // Mixed radix: the last child varies fastest
+        for (int c = back_pointer.child_count - 1; c >= 0; c--) {
+            int child = children[back_pointer.first_child + c];
+            stack.emplace_back(child, &tree->children[c]);
+            indices.push_back(rank % counts[child]);
+            rank /= counts[child];
+        }
+    }
+    return result;
+}
+
+ForestParser::ForestParser(const CFG &cfg) : grammar(cfg) {
+}
+
+ParseForest ForestParser::parse(const std::string &input) const {
+    const IndexedGrammar &indexed = grammar.grammar;
+    ParseForest forest;
+    forest.symbols = indexed.symbols;
+    const std::size_t n = input.size();
+
+    if (n == 0) {
+        for (int production: indexed.rules[grammar.start]) {
+            if (indexed.bodies[production].empty()) {
+                forest.root = 0;
+                forest.nodes.push_back({false, grammar.start, 0, 0, 0, 0, 1});
+                forest.nodes.push_back({true, production, 0, 0, 0, 0, 0});
+                forest.children.push_back(1);
+            }
+        }
+        return forest;
+    }
+    std::vector<int> tokens = grammar.tokenize(input);
+    if (std::find(tokens.begin(), tokens.end(), -1) != tokens.end()) {
+        return forest;
+    }
+
+    // Recognition with bitset cells, cell (i, length) at ((length - 1) * n + i) * words
+    const std::size_t words = grammar.words;
+    std::vector<std::uint64_t> chart(n * n * words, 0);
+    auto cell = [&chart, n, words](std::size_t i, std::size_t length) {
+        return &chart[((length - 1) * n + i) * words];
+    };
+    for (std::size_t i = 0; i < n; i++) {
+        for (const auto &rule: grammar.terminal_rules[tokens[i]]) {
+            setBit(cell(i, 1), rule.head);
+        }
+    }
+    for (std::size_t length = 2; length <= n; length++) {
+        for (std::size_t i = 0; i + length <= n; i++) {
+            std::uint64_t *target = cell(i, length);
+            for (std::size_t split = 1; split < length; split++) {
+                const std::uint64_t *right = cell(i + split, length - split);
+                forEachBit(cell(i, split), grammar.words, [&](int left) {
+                    for (int index: grammar.rules_by_left[left]) {
+                        const auto &rule = grammar.binary_rules[index];
+                        if (testBit(right, rule.right)) {
+                            setBit(target, rule.head);
+                        }
+                    }
+                });
+            }
+        }
+    }
+    if (!testBit(cell(0, n), grammar.start)) {
+        return forest;
+    }
+
+    // Hash-consed symbol nodes, the worklist holds the variable nodes whose back pointers are not recorded yet
+    std::unordered_map<std::uint64_t, int> ids;
+    std::vector<int> worklist;
+    auto symbolNode = [&](int symbol, std::size_t start, std::size_t length) {
+        std::uint64_t key = (static_cast<std::uint64_t>(symbol) * (n + 1) + start) * (n + 1) + length;
+        auto it = ids.find(key);
+        if (it != ids.end()) {
+            return it->second;
+        }
+        int id = static_cast<int>(forest.nodes.size());
+        ids.emplace(key, id);
+        forest.nodes.push_back({false, symbol, static_cast<int>(start), static_cast<int>(length), 0, 0, 0});
+        if (indexed.isVariable(symbol)) {
+            worklist.push_back(id);
+        }
+        return id;
+    };
+    auto packedNode = [&](int production, int split, std::initializer_list<int> body) {
+        int id = static_cast<int>(forest.nodes.size());
+        forest.nodes.push_back({true, production, 0, 0, split, static_cast<int>(forest.children.size()),
+                                static_cast<int>(body.size())});
+        forest.children.insert(forest.children.end(), body);
+        return id;
+    };
+
+    forest.root = symbolNode(grammar.start, 0, n);
+    std::vector<int> back_pointers;
+    while (!worklist.empty()) {
+        int node = worklist.back();
+        worklist.pop_back();
+        int head = forest.nodes[node].symbol;
+        std::size_t start = forest.nodes[node].start;
+        std::size_t length = forest.nodes[node].length;
+        back_pointers.clear();
+        if (length == 1) {
+            for (const auto &rule: grammar.terminal_rules[tokens[start]]) {
+                if (rule.head == head) {
+                    int leaf = symbolNode(indexed.bodies[rule.production][0], start, 1);
+                    back_pointers.push_back(packedNode(rule.production, 0, {leaf}));
+                }
+            }
+        } else {
+            for (std::size_t split = 1; split < length; split++) {
+                const std::uint64_t *left = cell(start, split);
+                const std::uint64_t *right = cell(start + split, length - split);
+                for (int production: indexed.rules[head]) {
+                    const auto &body = indexed.bodies[production];
+                    if (body.size() == 2 && testBit(left, body[0]) && testBit(right, body[1])) {
+                        int left_node = symbolNode(body[0], start, split);
+                        int right_node = symbolNode(body[1], start + split, length - split);
+                        back_pointers.push_back(packedNode(production, static_cast<int>(split),
+                                                           {left_node, right_node}));
+                    }
+                }
+            }
+        }
+        forest.nodes[node].first_child = static_cast<int>(forest.children.size());
+        forest.nodes[node].child_count = static_cast<int>(back_pointers.size());
+        forest.children.insert(forest.children.end(), back_pointers.begin(), back_pointers.end());
+    }
+    return forest;
+}
@@ -0,0 +1,179 @@
+//
+// Created by 2005e on 18/10/2026.
+//
+
+#include "../Headers/PreFilter.h"
+#include "../Headers/GrammarCleanup.h"
+#include "../Headers/YieldBounds.h"
+
+PreFilter::PreFilter(const CFG &cfg, const PreFilterOptions &options) : options(options) {
+    IndexedGrammar grammar(cfg);
+    const int variable_count = grammar.variable_count;
+    const std::size_t symbol_count = grammar.symbols.size();
+    terminal_count = static_cast<int>(symbol_count) - variable_count;
+
+    YieldBounds bounds(grammar);
+    min_length = bounds.min[grammar.start];
+    max_length = bounds.max[grammar.start];
+
+    // Only the useful productions: all symbols generating and the head reachable
+    std::vector<bool> is_generating = GrammarCleanup::generating(grammar);
+    std::vector<bool> useful(grammar.heads.size(), false);
+    for (std::size_t p = 0; p < grammar.heads.size(); p++) {
+        useful[p] = is_generating[grammar.heads[p]];
+        for (int symbol: grammar.bodies[p]) {
+            useful[p] = useful[p] && is_generating[symbol];
+        }
+    }
+    std::vector<bool> is_reachable = GrammarCleanup::reachable(grammar, useful);
+    for (std::size_t p = 0; p < grammar.heads.size(); p++) {
+        useful[p] = useful[p] && is_reachable[grammar.heads[p]];
+    }
+    std::vector<bool> nullable = GrammarCleanup::nullable(grammar);
+
+    char_terminals.fill(-1);
+    for (int symbol = variable_count; symbol < static_cast<int>(symbol_count); symbol++) {
+        if (grammar.symbols[symbol].size() == 1 && is_reachable[symbol]) {
+            char_terminals[static_cast<unsigned char>(grammar.symbols[symbol][0])] = symbol - variable_count;
+        }
+    }
+
+    // FIRST and LAST terminals of every symbol, as fixed points
+    std::vector<std::vector<bool>> first_sets(symbol_count, std::vector<bool>(terminal_count, false));
+    std::vector<std::vector<bool>> last_sets = first_sets;
+    for (int symbol = variable_count; symbol < static_cast<int>(symbol_count); symbol++) {
+        first_sets[symbol][symbol - variable_count] = true;
+        last_sets[symbol][symbol - variable_count] = true;
+    }
+    auto unite = [](std::vector<bool> &target, const std::vector<bool> &source) {
+        bool changed = false;
+        for (std::size_t t = 0; t < source.size(); t++) {
+            if (source[t] && !target[t]) {
+                target[t] = true;
+                changed = true;
+            }
+        }
+        return changed;
+    };
+    bool changed = true;
+    while (changed) {
+        changed = false;
+        for (std::size_t p = 0; p < grammar.heads.size(); p++) {
+            if (!useful[p]) {
+                continue;
+            }
+            const auto &body = grammar.bodies[p];
+            int head = grammar.heads[p];
+            for (int symbol: body) {
+                changed = unite(first_sets[head], first_sets[symbol]) || changed;
+                if (!nullable[symbol]) {
+                    break;
+                }
+            }
+            for (auto it = body.rbegin(); it != body.rend(); it++) {
+                changed = unite(last_sets[head], last_sets[*it]) || changed;
+                if (!nullable[*it]) {
+                    break;
+                }
+            }
+        }
+    }
+    first = first_sets[grammar.start];
+    last = last_sets[grammar.start];
+
+    // A pair of adjacent terminals is split between two symbols of a body with only nullable symbols in between
+    bigrams.assign(static_cast<std::size_t>(terminal_count) * terminal_count, false);
+    for (std::size_t p = 0; p < grammar.heads.size(); p++) {
+        if (!useful[p]) {
+            continue;
+        }
+        const auto &body = grammar.bodies[p];
+        for (std::size_t i = 0; i < body.size(); i++) {
+            for (std::size_t j = i + 1; j < body.size(); j++) {
+                for (int left = 0; left < terminal_count; left++) {
+                    if (!last_sets[body[i]][left]) {
+                        continue;
+                    }
+                    for (int right = 0; right < terminal_count; right++) {
+                        if (first_sets[body[j]][right]) {
+                            bigrams[left * terminal_count + right] = true;
+                        }
+                    }
+                }
+                if (!nullable[body[j]]) {
+                    break;
+                }
+            }
+        }
+    }
+}
+
+bool PreFilter::reject(Filter filter) const {
+    fired[static_cast<int>(filter)].fetch_add(1, std::memory_order_relaxed);
+    return false;
+}
+
+bool PreFilter::check(const std::string &input) const {
+    checked.fetch_add(1, std::memory_order_relaxed);
+    if (options.length && (input.size() < min_length || input.size() > max_length)) {
+        return reject(Filter::Length);
+    }
+    if (input.empty()) {
+        return true;
+    }
+
+    // One pass over the input, the alphabet is checked for every character before its bigram
+    int previous = -1;
+    for (std::size_t i = 0; i < input.size(); i++) {
+        int terminal = char_terminals[static_cast<unsigned char>(input[i])];
+        if (terminal < 0) {
+            if (options.alphabet) {
+                return reject(Filter::Alphabet);
+            }
+            previous = -1;
+            continue;
+        }
+        if (i == 0 && options.first && !first[terminal]) {
+            return reject(Filter::First);
+        }
+        if (previous >= 0 && options.bigram && !bigrams[previous * terminal_count + terminal]) {
+            return reject(Filter::Bigram);
+        }
+        previous = terminal;
+    }
+    int final_terminal = char_terminals[static_cast<unsigned char>(input.back())];
+    if (options.last && final_terminal >= 0 && !last[final_terminal]) {
+        return reject(Filter::Last);
+    }
+    return true;
+}
+
+std::size_t PreFilter::getFired(Filter filter) const {
+    return fired[static_cast<int>(filter)].load(std::memory_order_relaxed);
+}
+
+std::size_t PreFilter::getChecked() const {
+    return checked.load(std::memory_order_relaxed);
+}
+
+std::string PreFilter::filterName(Filter filter) {
+    switch (filter) {
+        case Filter::Length:
+            return "length";
+        case Filter::Alphabet:
+            return "alphabet";
+        case Filter::First:
+            return "first";
+        case Filter::Last:
+            return "last";
+        default:
+            return "bigram";
+    }
+}
+
+void PreFilter::resetCounters() {
+    for (auto &counter: fired) {
+        counter.store(0, std::memory_order_relaxed);
+    }
+    checked.store(0, std::memory_order_relaxed);
+}
@@ -0,0 +1,138 @@
+//
+// Created by 2005e on 18/10/2026.
+//
+
+#include "../Headers/PredictiveParser.h"
+#include "../Headers/GrammarCleanup.h"
+
+PredictiveParser::PredictiveParser(const IndexedGrammar &grammar)
+        : variable_count(grammar.variable_count), start(grammar.start), bodies(grammar.bodies),
+          char_terminals(grammar.char_terminals) {
+
+    int terminal_count = static_cast<int>(grammar.symbols.size()) - variable_count;
+    column_count = terminal_count + 1;
+    int words = (column_count + 63) / 64;
+    std::vector<bool> nullable = GrammarCleanup::nullable(grammar);
+
+    // FIRST and FOLLOW of every variable as bitsets over the columns
+    std::vector<std::uint64_t> first(static_cast<std::size_t>(variable_count) * words, 0);
+    std::vector<std::uint64_t> follow(static_cast<std::size_t>(variable_count) * words, 0);
+    auto unite = [words](std::uint64_t *target, const std::uint64_t *source) {
+        bool changed = false;
+        for (int w = 0; w < words; w++) {
+            std::uint64_t merged = target[w] | source[w];
+            changed = changed || merged != target[w];
+            target[w] = merged;
+        }
+        return changed;
+    };
+    auto add = [](std::uint64_t *target, int column) {
+        std::uint64_t bit = std::uint64_t{1} << (column & 63);
+        bool changed = !(target[column >> 6] & bit);
+        target[column >> 6] |= bit;
+        return changed;
+    };
+
+    // Adds FIRST of body[from..] to target, returns true if that suffix is nullable
+    auto addFirst = [&](std::uint64_t *target, const std::vector<int> &body, std::size_t from, bool &changed) {
+        for (std::size_t i = from; i < body.size(); i++) {
+            int symbol = body[i];
+            if (!grammar.isVariable(symbol)) {
+                changed = add(target, symbol - variable_count) || changed;
+                return false;
+            }
+            changed = unite(target, &first[static_cast<std::size_t>(symbol) * words]) || changed;
+            if (!nullable[symbol]) {
+                return false;
+            }
+        }
+        return true;
+    };
+
+    bool changed = true;
+    while (changed) {
+        changed = false;
+        for (std::size_t p = 0; p < bodies.size(); p++) {
+            addFirst(&first[static_cast<std::size_t>(grammar.heads[p]) * words], bodies[p], 0, changed);
+        }
+    }
+
+    add(&follow[static_cast<std::size_t>(start) * words], terminal_count);
+    changed = true;
+    while (changed) {
+        changed = false;
+        for (std::size_t p = 0; p < bodies.size(); p++) {
+            const auto &body = bodies[p];
+            for (std::size_t i = 0; i < body.size(); i++) {
+                if (!grammar.isVariable(body[i])) {
+                    continue;
+                }
+                std::uint64_t *target = &follow[static_cast<std::size_t>(body[i]) * words];
+                if (addFirst(target, body, i + 1, changed)) {
+                    changed = unite(target, &follow[static_cast<std::size_t>(grammar.heads[p]) * words]) || changed;
+                }
+            }
+        }
+    }
+
+    // Parse table
+    table.assign(static_cast<std::size_t>(variable_count) * column_count, -1);
+    std::vector<std::uint64_t> lookahead(words);
+    for (std::size_t p = 0; p < bodies.size(); p++) {
+        int head = grammar.heads[p];
+        std::fill(lookahead.begin(), lookahead.end(), 0);
+        bool unused = false;
+        if (addFirst(lookahead.data(), bodies[p], 0, unused)) {
+            unite(lookahead.data(), &follow[static_cast<std::size_t>(head) * words]);
+        }
+        for (int column = 0; column < column_count; column++) {
+            if (!((lookahead[column >> 6] >> (column & 63)) & 1)) {
+                continue;
+            }
+            int &entry = table[static_cast<std::size_t>(head) * column_count + column];
+            if (entry != -1 && entry != static_cast<int>(p)) {
+                conflicts = true;
+            }
+            entry = static_cast<int>(p);
+        }
+    }
+}
+
+bool PredictiveParser::isLL1() const {
+    return !conflicts;
+}
+
+bool PredictiveParser::accepts(const std::string &input) const {
+    if (conflicts) {
+        throw (std::runtime_error("PredictiveParser error::the grammar is not LL(1)"));
+    }
+    int end_column = column_count - 1;
+    std::vector<int> stack{start};
+    std::size_t position = 0;
+    while (!stack.empty()) {
+        int symbol = stack.back();
+        stack.pop_back();
+        int column = end_column;
+        if (position < input.size()) {
+            int terminal = char_terminals[static_cast<unsigned char>(input[position])];
+            if (terminal < 0) {
+                return false;
+            }
+            column = terminal - variable_count;
+        }
+        if (symbol >= variable_count) {
+            if (symbol - variable_count != column || column == end_column) {
+                return false;
+            }
+            position++;
+            continue;
+        }
+        int production = table[static_cast<std::size_t>(symbol) * column_count + column];
+        if (production < 0) {
+            return false;
+        }
+        const auto &body = bodies[production];
+        stack.insert(stack.end(), body.rbegin(), body.rend());
+    }
+    return position == input.size();
+}
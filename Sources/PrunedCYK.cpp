@@ -0,0 +1,138 @@
+//
+// Created by 2005e on 18/10/2026.
+//
+
+#include <algorithm>
+
+#include "../Headers/PrunedCYK.h"
+
+PrunedCYK::PrunedCYK(const CFG &cfg) : grammar(cfg), bounds(grammar.grammar) {
+    // A rule with two unbounded children (like S -> S S) marks its children at almost every span and split,
+    // the top-down masks then become full and the pass only costs time
+    top_down = std::none_of(grammar.binary_rules.begin(), grammar.binary_rules.end(), [this](const BinaryRule &rule) {
+        return bounds.max[rule.left] == YieldBounds::infinite && bounds.max[rule.right] == YieldBounds::infinite;
+    });
+}
+
+bool PrunedCYK::accepts(const std::string &input) const {
+    const std::size_t n = input.size();
+    if (n == 0) {
+        return grammar.accepts_empty;
+    }
+    if (!bounds.fits(grammar.start, n)) {
+        return false;
+    }
+    std::vector<int> tokens = grammar.tokenize(input);
+    if (std::find(tokens.begin(), tokens.end(), -1) != tokens.end()) {
+        return false;
+    }
+
+    // Cell (i, length) at ((length - 1) * n + i) * words, in the chart and in the mask of needed variables
+    const std::size_t words = grammar.words;
+    std::vector<std::uint64_t> chart(n * n * words, 0);
+    std::vector<std::uint64_t> needed(top_down ? n * n * words : 0, 0);
+    auto cell = [n, words](std::vector<std::uint64_t> &table, std::size_t i, std::size_t length) {
+        return &table[((length - 1) * n + i) * words];
+    };
+
+    // The splits of a rule over a span of the given length where both children fit their bounds
+    auto splitRange = [this](const BinaryRule &rule, std::size_t length) {
+        std::size_t first = std::max<std::size_t>(1, bounds.min[rule.left]);
+        if (bounds.max[rule.right] != YieldBounds::infinite && length > bounds.max[rule.right]) {
+            first = std::max(first, length - bounds.max[rule.right]);
+        }
+        std::size_t last = length - 1;
+        if (bounds.max[rule.left] < last) {
+            last = bounds.max[rule.left];
+        }
+        if (bounds.min[rule.right] > length - 1) {
+            return std::make_pair(std::size_t{1}, std::size_t{0});
+        }
+        last = std::min(last, length - std::max<std::size_t>(1, bounds.min[rule.right]));
+        return std::make_pair(first, last);
+    };
+
+    // Top-down filter
+    if (top_down) {
+        setBit(cell(needed, 0, n), grammar.start);
+        for (std::size_t length = n; length >= 2; length--) {
+            for (std::size_t i = 0; i + length <= n; i++) {
+                forEachBit(cell(needed, i, length), grammar.words, [&](int head) {
+                    for (int index: grammar.rules_by_head[head]) {
+                        const auto &rule = grammar.binary_rules[index];
+                        auto [first, last] = splitRange(rule, length);
+                        for (std::size_t split = first; split <= last; split++) {
+                            setBit(cell(needed, i, split), rule.left);
+                            setBit(cell(needed, i + split, length - split), rule.right);
+                        }
+                    }
+                });
+            }
+        }
+    }
+
+    // Without the top-down pass every cell of a length shares the splits where some rule fits
+    std::vector<std::pair<std::size_t, std::size_t>> length_splits;
+    if (!top_down) {
+        length_splits.assign(n + 1, {1, 0});
+        for (std::size_t length = 2; length <= n; length++) {
+            auto &[first, last] = length_splits[length];
+            first = length;
+            for (const auto &rule: grammar.binary_rules) {
+                auto range = splitRange(rule, length);
+                if (range.first <= range.second) {
+                    first = std::min(first, range.first);
+                    last = std::max(last, range.second);
+                }
+            }
+        }
+    }
+
+    // Bottom-up pass over the needed variables
+    for (std::size_t i = 0; i < n; i++) {
+        for (const auto &rule: grammar.terminal_rules[tokens[i]]) {
+            if (!top_down || testBit(cell(needed, i, 1), rule.head)) {
+                setBit(cell(chart, i, 1), rule.head);
+            }
+        }
+    }
+    for (std::size_t length = 2; length <= n; length++) {
+        for (std::size_t i = 0; i + length <= n; i++) {
+            const std::uint64_t *mask = top_down ? cell(needed, i, length) : nullptr;
+            std::size_t first = length_splits.empty() ? length : length_splits[length].first;
+            std::size_t last = length_splits.empty() ? 0 : length_splits[length].second;
+            if (top_down) {
+                // Only the splits where a rule of a needed head fits its children
+                forEachBit(mask, grammar.words, [&](int head) {
+                    for (int index: grammar.rules_by_head[head]) {
+                        auto range = splitRange(grammar.binary_rules[index], length);
+                        if (range.first <= range.second) {
+                            first = std::min(first, range.first);
+                            last = std::max(last, range.second);
+                        }
+                    }
+                });
+            }
+
+            // A set bit of a child already fits its span (the chart only holds fitting variables), so within the
+            // split range only the heads are filtered here
+            std::uint64_t *target = cell(chart, i, length);
+            for (std::size_t split = first; split <= last; split++) {
+                const std::uint64_t *right = cell(chart, i + split, length - split);
+                forEachBit(cell(chart, i, split), grammar.words, [&](int left) {
+                    for (int index: grammar.rules_by_left[left]) {
+                        const auto &rule = grammar.binary_rules[index];
+                        if ((!mask || testBit(mask, rule.head)) && testBit(right, rule.right)) {
+                            setBit(target, rule.head);
+                        }
+                    }
+                });
+            }
+        }
+    }
+    return testBit(cell(chart, 0, n), grammar.start);
+}
+
+const YieldBounds &PrunedCYK::getBounds() const {
+    return bounds;
+}
@@ -0,0 +1,94 @@
+//
+// Created by 2005e on 18/10/2026.
+//
+
+#include "../Headers/Recognizer.h"
+#include "../Headers/DFA.h"
+#include "../Headers/PredictiveParser.h"
+#include "../Headers/BitsetCYK.h"
+#include "../Headers/CNFGrammar.h"
+#include "../Headers/ValiantRecognizer.h"
+#include "../Headers/EarleyParser.h"
+#include "../Headers/PreFilter.h"
+
+Recognizer::Recognizer(const CFG &cfg) {
+    IndexedGrammar grammar(cfg);
+
+    if (DFA::linearity(grammar) != DFA::Linearity::None) {
+        try {
+            dfa = std::make_shared<DFA>(cfg, max_dfa_states);
+            engine = Engine::DFA;
+            reason = "the grammar is regular (linear), compiled to a minimal DFA with " +
+                     std::to_string(dfa->size()) + " states";
+            return;
+        } catch (const std::runtime_error &) {
+            reason = "regular, but the DFA exceeds " + std::to_string(max_dfa_states) + " states; ";
+        }
+    } else {
+        reason = "not regular; ";
+    }
+
+    auto parser = std::make_shared<PredictiveParser>(grammar);
+    if (parser->isLL1()) {
+        predictive = parser;
+        engine = Engine::LL1;
+        reason += "the LL(1) parse table has no conflicts";
+        return;
+    }
+    reason += "the LL(1) parse table has conflicts; ";
+
+    if (CNFGrammar::isCNF(grammar)) {
+        cyk = std::make_shared<BitsetCYK>(cfg);
+        valiant = std::make_shared<ValiantRecognizer>(cfg);
+        prefilter = std::make_shared<PreFilter>(cfg);
+        engine = Engine::CYK;
+        reason += "the grammar is in Chomsky normal form (Valiant from length " + std::to_string(valiant_length) + ")";
+        return;
+    }
+
+    earley = std::make_shared<EarleyParser>(cfg);
+    prefilter = std::make_shared<PreFilter>(cfg);
+    engine = Engine::Earley;
+    reason += "not in Chomsky normal form, using Earley";
+}
+
+bool Recognizer::accepts(const std::string &input) const {
+    switch (engine) {
+        case Engine::DFA:
+            return dfa->accepts(input);
+        case Engine::LL1:
+            return predictive->accepts(input);
+        case Engine::CYK:
+            if (!prefilter->check(input)) {
+                return false;
+            }
+            return input.size() < valiant_length ? cyk->accepts(input) : valiant->accepts(input);
+        default:
+            return prefilter->check(input) && earley->accepts(input);
+    }
+}
+
+Recognizer::Engine Recognizer::getEngine() const {
+    return engine;
+}
+
+std::string Recognizer::getEngineName() const {
+    switch (engine) {
+        case Engine::DFA:
+            return "DFA";
+        case Engine::LL1:
+            return "LL(1)";
+        case Engine::CYK:
+            return "CYK";
+        default:
+            return "Earley";
+    }
+}
+
+const std::string &Recognizer::getReason() const {
+    return reason;
+}
+
+std::shared_ptr<const PreFilter> Recognizer::getPreFilter() const {
+    return prefilter;
+}
@@ -0,0 +1,99 @@
+//
+// Created by 2005e on 18/10/2026.
+//
+
+#include "../Headers/SubstringChart.h"
+
+SubstringChart::SubstringChart(const CFG &cfg, std::string input) : grammar(cfg), input(std::move(input)) {
+    const std::size_t n = this->input.size();
+    chart.assign(n * (n + 1) / 2 * grammar.words, 0);
+
+    std::vector<int> tokens = grammar.tokenize(this->input);
+    for (std::size_t i = 0; i < n; i++) {
+        if (tokens[i] < 0) {
+            continue;
+        }
+        for (const auto &rule: grammar.terminal_rules[tokens[i]]) {
+            setBit(cell(i, i + 1), rule.head);
+        }
+    }
+    for (std::size_t length = 2; length <= n; length++) {
+        for (std::size_t i = 0; i + length <= n; i++) {
+            std::uint64_t *target = cell(i, i + length);
+            for (std::size_t split = 1; split < length; split++) {
+                const std::uint64_t *right = cell(i + split, i + length);
+                forEachBit(cell(i, i + split), grammar.words, [&](int left) {
+                    for (int index: grammar.rules_by_left[left]) {
+                        const auto &rule = grammar.binary_rules[index];
+                        if (testBit(right, rule.right)) {
+                            setBit(target, rule.head);
+                        }
+                    }
+                });
+            }
+        }
+    }
+}
+
+bool SubstringChart::derives(int variable, std::size_t start, std::size_t end) const {
+    const std::size_t n = input.size();
+    if (variable < 0 || variable >= grammar.variable_count) {
+        throw (std::runtime_error("SubstringChart error::" + std::to_string(variable) + " is not a variable id"));
+    }
+    if (start > end || end > n) {
+        throw (std::runtime_error("SubstringChart error::the span [" + std::to_string(start) + ", " +
+                                  std::to_string(end) + ") is not inside the input"));
+    }
+    if (start == end) {
+        return variable == grammar.start && grammar.accepts_empty;
+    }
+    return testBit(cell(start, end), variable);
+}
+
+bool SubstringChart::derives(const std::string &variable, std::size_t start, std::size_t end) const {
+    return derives(variableId(variable), start, end);
+}
+
+std::vector<Span> SubstringChart::maximalSpans(const std::string &variable) const {
+    const int id = variableId(variable);
+    const std::size_t n = input.size();
+    std::vector<Span> spans;
+
+    // The longest span of every start is the only candidate of that start. It is maximal if no earlier
+    // start reaches as far, because a span derived from an earlier start with a later end would contain it.
+    std::size_t furthest = 0;
+    for (std::size_t i = 0; i < n; i++) {
+        for (std::size_t end = n; end > std::max(i, furthest); end--) {
+            if (derives(id, i, end)) {
+                spans.push_back({i, end});
+                furthest = end;
+                break;
+            }
+        }
+    }
+    return spans;
+}
+
+int SubstringChart::variableId(const std::string &variable) const {
+    auto it = grammar.grammar.ids.find(variable);
+    if (it == grammar.grammar.ids.end() || !grammar.grammar.isVariable(it->second)) {
+        throw (std::runtime_error("SubstringChart error::" + variable + " is not a variable"));
+    }
+    return it->second;
+}
+
+std::uint64_t *SubstringChart::cell(std::size_t start, std::size_t end) {
+    return &chart[(end * (end - 1) / 2 + start) * grammar.words];
+}
+
+const std::uint64_t *SubstringChart::cell(std::size_t start, std::size_t end) const {
+    return &chart[(end * (end - 1) / 2 + start) * grammar.words];
+}
+
+const std::string &SubstringChart::getInput() const {
+    return input;
+}
+
+const CNFGrammar &SubstringChart::getGrammar() const {
+    return grammar;
+}
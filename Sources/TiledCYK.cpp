@@ -0,0 +1,89 @@
+//
+// Created by 2005e on 18/10/2026.
+//
+
+#include <algorithm>
+
+#include "../Headers/TiledCYK.h"
+
+TiledCYK::TiledCYK(const CFG &cfg, std::size_t tile_size) : grammar(cfg), tile_size(std::max<std::size_t>(tile_size, 1)) {
+}
+
+bool TiledCYK::accepts(const std::string &input) const {
+    const std::size_t n = input.size();
+    if (n == 0) {
+        return grammar.accepts_empty;
+    }
+    std::vector<int> tokens = grammar.tokenize(input);
+    if (std::find(tokens.begin(), tokens.end(), -1) != tokens.end()) {
+        return false;
+    }
+    const std::size_t words = grammar.words;
+
+    // Row-major copy: row i holds the cells (i, e) for e in [i, n); column-major copy: column e holds (i, e) for i in [0, e]
+    std::vector<std::uint64_t> rows(n * (n + 1) / 2 * words, 0);
+    std::vector<std::uint64_t> columns(n * (n + 1) / 2 * words, 0);
+    auto rowCell = [&rows, n, words](std::size_t i, std::size_t e) {
+        return &rows[(i * (2 * n - i + 1) / 2 + (e - i)) * words];
+    };
+    auto columnCell = [&columns, words](std::size_t i, std::size_t e) {
+        return &columns[(e * (e + 1) / 2 + i) * words];
+    };
+
+    // Adds the splits k in [first, last) to cell (i, e): left (i, k) from the row, right (k + 1, e) from the column
+    auto combine = [&](std::size_t i, std::size_t e, std::size_t first, std::size_t last) {
+        std::uint64_t *target = rowCell(i, e);
+        const std::uint64_t *left = rowCell(i, first);
+        const std::uint64_t *right = columnCell(first + 1, e);
+        for (std::size_t k = first; k < last; k++, left += words, right += words) {
+            forEachBit(left, grammar.words, [&](int variable) {
+                for (int index: grammar.rules_by_left[variable]) {
+                    const auto &rule = grammar.binary_rules[index];
+                    if (testBit(right, rule.right)) {
+                        setBit(target, rule.head);
+                    }
+                }
+            });
+        }
+    };
+
+    const std::size_t tiles = (n + tile_size - 1) / tile_size;
+    for (std::size_t diagonal = 0; diagonal < tiles; diagonal++) {
+        for (std::size_t row_tile = 0; row_tile + diagonal < tiles; row_tile++) {
+            std::size_t column_tile = row_tile + diagonal;
+            std::size_t row_begin = row_tile * tile_size;
+            std::size_t row_end = std::min(row_begin + tile_size, n);
+            std::size_t column_begin = column_tile * tile_size;
+            std::size_t column_end = std::min(column_begin + tile_size, n);
+
+            // Splits in the tiles between the row tile and the column tile, those cells are all done
+            for (std::size_t split_begin = row_end; split_begin < column_begin; split_begin += tile_size) {
+                std::size_t split_end = std::min(split_begin + tile_size, column_begin);
+                for (std::size_t i = row_begin; i < row_end; i++) {
+                    for (std::size_t e = column_begin; e < column_end; e++) {
+                        combine(i, e, split_begin, split_end);
+                    }
+                }
+            }
+
+            // Splits inside the row tile and the column tile depend on cells of this tile: the cells below
+            // in the same column and left in the same row, so go up the rows and right along the columns
+            for (std::size_t i = row_end; i-- > row_begin;) {
+                for (std::size_t e = std::max(column_begin, i); e < column_end; e++) {
+                    if (i == e) {
+                        for (const auto &rule: grammar.terminal_rules[tokens[i]]) {
+                            setBit(rowCell(i, i), rule.head);
+                        }
+                    } else if (row_tile == column_tile) {
+                        combine(i, e, i, e);
+                    } else {
+                        combine(i, e, i, row_end);
+                        combine(i, e, column_begin, e);
+                    }
+                    std::copy(rowCell(i, e), rowCell(i, e) + words, columnCell(i, e));
+                }
+            }
+        }
+    }
+    return testBit(rowCell(0, n - 1), grammar.start);
+}
@@ -0,0 +1,183 @@
+//
+// Created by 2005e on 18/10/2026.
+//
+
+#include "../Headers/ValiantRecognizer.h"
+
+ValiantRecognizer::ValiantRecognizer(const CFG &cfg) : grammar(cfg) {
+    rules_by_right.resize(grammar.variable_count);
+    for (const auto &rule: grammar.binary_rules) {
+        rules_by_right[rule.right].push_back({rule.head, rule.left});
+    }
+}
+
+bool ValiantRecognizer::accepts(const std::string &input) const {
+    const std::size_t n = input.size();
+    if (n == 0) {
+        return grammar.accepts_empty;
+    }
+    std::vector<int> tokens = grammar.tokenize(input);
+
+    Chart chart;
+    chart.size = 2;
+    while (chart.size < n + 1) {
+        chart.size *= 2;
+    }
+    chart.row_words = (chart.size + 63) / 64;
+    chart.bits.assign(grammar.variable_count * chart.size * chart.row_words, 0);
+
+    for (std::size_t i = 0; i < n; i++) {
+        if (tokens[i] < 0) {
+            return false;
+        }
+        for (const auto &rule: grammar.terminal_rules[tokens[i]]) {
+            setBit(chart.row(rule.head, i), static_cast<int>(i + 1));
+        }
+    }
+    compute(chart, 0, chart.size);
+    return testBit(chart.row(grammar.start, 0), static_cast<int>(n));
+}
+
+void ValiantRecognizer::compute(Chart &chart, std::size_t l, std::size_t m) const {
+    std::size_t middle = (l + m) / 2;
+    if (m - l >= 4) {
+        compute(chart, l, middle);
+        compute(chart, middle, m);
+    }
+    complete(chart, l, middle, middle, m);
+}
+
+void ValiantRecognizer::complete(Chart &chart, std::size_t l, std::size_t m, std::size_t l2, std::size_t m2) const {
+    std::size_t size = m - l;
+    if (size <= leaf_size) {
+        completeLeaf(chart, l, m, l2, m2);
+        return;
+    }
+    std::size_t half = size / 2;
+    std::size_t k = l + half;
+    std::size_t k2 = l2 + half;
+
+    // The quarter nearest to the diagonal first, the one furthest away last
+    complete(chart, k, m, l2, k2);
+    multiply(chart, l, k, l2, half);
+    complete(chart, l, k, l2, k2);
+    multiply(chart, k, l2, k2, half);
+    complete(chart, k, m, k2, m2);
+    multiply(chart, l, k, k2, half);
+    multiply(chart, l, l2, k2, half);
+    complete(chart, l, k, k2, m2);
+}
+
+void ValiantRecognizer::completeLeaf(Chart &chart, std::size_t l, std::size_t m, std::size_t l2,
+                                     std::size_t m2) const {
+    // The rows [l, m) and the columns [l2, m2) each fit in one word
+    const std::size_t size = m - l;
+    const std::size_t column_word = l2 / 64;
+    const std::size_t row_word = l / 64;
+    const std::uint64_t block = size == 64 ? ~std::uint64_t{0} : ((std::uint64_t{1} << size) - 1) << (l2 & 63);
+    const std::uint64_t split_block = size == 64 ? ~std::uint64_t{0} : ((std::uint64_t{1} << size) - 1) << (l & 63);
+
+    for (std::size_t i = m; i-- > l;) {
+        // Splits in (i, m): the cells below in the same column are already done
+        std::uint64_t below = split_block & ~((std::uint64_t{2} << (i & 63)) - 1);
+        for (int right = 0; right < grammar.variable_count; right++) {
+            for (const auto &rule: rules_by_right[right]) {
+                std::uint64_t splits = chart.row(rule.left, i)[row_word] & below;
+                std::uint64_t &target = chart.row(rule.head, i)[column_word];
+                while (splits) {
+                    std::size_t split = row_word * 64 + __builtin_ctzll(splits);
+                    target |= chart.row(right, split)[column_word] & block;
+                    splits &= splits - 1;
+                }
+            }
+        }
+        // Splits in [l2, m2): cell (i, split) is final once the splits left of it are added
+        for (std::size_t split = l2; split < m2; split++) {
+            std::uint64_t above = block & ~((std::uint64_t{2} << (split & 63)) - 1);
+            for (const auto &rule: grammar.binary_rules) {
+                if (testBit(chart.row(rule.left, i), static_cast<int>(split))) {
+                    chart.row(rule.head, i)[column_word] |= chart.row(rule.right, split)[column_word] & above;
+                }
+            }
+        }
+    }
+}
+
+void ValiantRecognizer::multiply(Chart &chart, std::size_t rows, std::size_t splits, std::size_t columns,
+                                 std::size_t size) const {
+    const std::size_t words = size / 64;
+    const std::size_t column_word = columns / 64;
+    const std::size_t split_word = splits / 64;
+
+    if (size < four_russians_size) {
+        for (int right = 0; right < grammar.variable_count; right++) {
+            for (const auto &rule: rules_by_right[right]) {
+                for (std::size_t i = rows; i < rows + size; i++) {
+                    const std::uint64_t *left = chart.row(rule.left, i) + split_word;
+                    std::uint64_t *target = chart.row(rule.head, i) + column_word;
+                    for (std::size_t w = 0; w < words; w++) {
+                        std::uint64_t bits = left[w];
+                        while (bits) {
+                            const std::uint64_t *source = chart.row(right, splits + w * 64 + __builtin_ctzll(bits)) +
+                                                          column_word;
+                            for (std::size_t c = 0; c < words; c++) {
+                                target[c] |= source[c];
+                            }
+                            bits &= bits - 1;
+                        }
+                    }
+                }
+            }
+        }
+        return;
+    }
+
+    // Method of Four Russians: the splits are taken 8 at a time, a table holds the OR of every subset
+    // of those 8 rows of the right matrix, and every row of the left matrix needs one lookup per 8 splits
+    std::vector<std::uint64_t> table(256 * words);
+    for (int right = 0; right < grammar.variable_count; right++) {
+        if (rules_by_right[right].empty()) {
+            continue;
+        }
+        for (std::size_t group = 0; group < size; group += 8) {
+            bool empty = true;
+            for (std::size_t s = 0; s < 8 && empty; s++) {
+                const std::uint64_t *source = chart.row(right, splits + group + s) + column_word;
+                for (std::size_t c = 0; c < words; c++) {
+                    if (source[c]) {
+                        empty = false;
+                        break;
+                    }
+                }
+            }
+            if (empty) {
+                continue;
+            }
+            std::fill(table.begin(), table.begin() + words, 0);
+            for (std::size_t subset = 1; subset < 256; subset++) {
+                std::size_t lowest = subset & (~subset + 1);
+                const std::uint64_t *source = chart.row(right, splits + group + __builtin_ctzll(subset)) + column_word;
+                const std::uint64_t *rest = &table[(subset ^ lowest) * words];
+                std::uint64_t *entry = &table[subset * words];
+                for (std::size_t c = 0; c < words; c++) {
+                    entry[c] = rest[c] | source[c];
+                }
+            }
+            const std::size_t word = split_word + group / 64;
+            const std::size_t shift = group & 63;
+            for (const auto &rule: rules_by_right[right]) {
+                for (std::size_t i = rows; i < rows + size; i++) {
+                    std::size_t subset = (chart.row(rule.left, i)[word] >> shift) & 0xff;
+                    if (subset == 0) {
+                        continue;
+                    }
+                    const std::uint64_t *entry = &table[subset * words];
+                    std::uint64_t *target = chart.row(rule.head, i) + column_word;
+                    for (std::size_t c = 0; c < words; c++) {
+                        target[c] |= entry[c];
+                    }
+                }
+            }
+        }
+    }
+}
@@ -0,0 +1,176 @@
+//
+// Created by 2005e on 18/10/2026.
+//
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+#include "../Headers/ViterbiParser.h"
+
+std::string ParseTree::toString() const {
+    if (children.empty()) {
+        return symbol;
+    }
+    std::string result = "(" + symbol;
+    for (const auto &child: children) {
+        result += " " + child.toString();
+    }
+    return result + ")";
+}
+
+ViterbiParser::ViterbiParser(const CFG &cfg) : grammar(cfg) {
+    for (double probability: grammar.grammar.probabilities) {
+        log_weights.push_back(std::log(probability));
+    }
+}
+
+namespace {
+    const double impossible = -std::numeric_limits<double>::infinity();
+
+    /**
+     * Best derivation of a variable in a cell: its log probability and how it was built,
+     * split is 0 for a terminal rule and rule is a production id
+     */
+    struct ViterbiEntry {
+        double score = impossible;
+        int split = 0;
+        int rule = -1;
+    };
+}
+
+ViterbiParse ViterbiParser::parse(const std::string &input, const BeamOptions &options) const {
+    ViterbiParse result;
+    const IndexedGrammar &indexed = grammar.grammar;
+    const std::size_t n = input.size();
+    const std::size_t variables = grammar.variable_count;
+
+    if (n == 0) {
+        for (int production: indexed.rules[grammar.start]) {
+            if (indexed.bodies[production].empty() && log_weights[production] > impossible) {
+                result.found = true;
+                result.log_probability = log_weights[production];
+                result.probability = std::exp(result.log_probability);
+                result.tree.symbol = indexed.symbols[grammar.start];
+            }
+        }
+        return result;
+    }
+    std::vector<int> tokens = grammar.tokenize(input);
+    if (std::find(tokens.begin(), tokens.end(), -1) != tokens.end()) {
+        return result;
+    }
+
+    // Cell (i, length) is stored at (length - 1) * n + i, its live variables in live[cell]
+    std::vector<ViterbiEntry> chart(n * n * variables);
+    std::vector<std::vector<int>> live(n * n);
+    auto cellIndex = [n](std::size_t i, std::size_t length) {
+        return (length - 1) * n + i;
+    };
+
+    // Applies the beam and threshold to the touched variables of a cell and stores the survivors
+    std::vector<int> touched;
+    std::vector<bool> is_touched(variables, false);
+    auto prune = [&](std::size_t cell) {
+        ViterbiEntry *entries = &chart[cell * variables];
+        double best = impossible;
+        for (int variable: touched) {
+            is_touched[variable] = false;
+            best = std::max(best, entries[variable].score);
+        }
+        if (options.threshold > 0.0) {
+            double bound = best + std::log(options.threshold);
+            touched.erase(std::remove_if(touched.begin(), touched.end(), [&](int variable) {
+                if (entries[variable].score < bound) {
+                    entries[variable] = ViterbiEntry();
+                    return true;
+                }
+                return false;
+            }), touched.end());
+        }
+        if (options.beam > 0 && touched.size() > options.beam) {
+            std::nth_element(touched.begin(), touched.begin() + options.beam, touched.end(), [entries](int a, int b) {
+                return entries[a].score > entries[b].score;
+            });
+            for (std::size_t k = options.beam; k < touched.size(); k++) {
+                entries[touched[k]] = ViterbiEntry();
+            }
+            touched.resize(options.beam);
+        }
+        live[cell].swap(touched);
+        touched.clear();
+    };
+    auto relax = [&](ViterbiEntry *entries, int head, double score, int split, int rule) {
+        if (score == impossible || score <= entries[head].score) {
+            return;
+        }
+        if (!is_touched[head]) {
+            is_touched[head] = true;
+            touched.push_back(head);
+        }
+        entries[head] = {score, split, rule};
+    };
+
+    for (std::size_t i = 0; i < n; i++) {
+        std::size_t cell = cellIndex(i, 1);
+        for (const auto &rule: grammar.terminal_rules[tokens[i]]) {
+            relax(&chart[cell * variables], rule.head, log_weights[rule.production], 0, rule.production);
+        }
+        prune(cell);
+    }
+    for (std::size_t length = 2; length <= n; length++) {
+        for (std::size_t i = 0; i + length <= n; i++) {
+            std::size_t cell = cellIndex(i, length);
+            ViterbiEntry *target = &chart[cell * variables];
+            for (std::size_t split = 1; split < length; split++) {
+                std::size_t left_cell = cellIndex(i, split);
+                const ViterbiEntry *left = &chart[left_cell * variables];
+                const ViterbiEntry *right = &chart[cellIndex(i + split, length - split) * variables];
+                for (int variable: live[left_cell]) {
+                    for (int r: grammar.rules_by_left[variable]) {
+                        const auto &rule = grammar.binary_rules[r];
+                        if (right[rule.right].score == impossible) {
+                            continue;
+                        }
+                        double score = log_weights[rule.production] + left[variable].score + right[rule.right].score;
+                        relax(target, rule.head, score, static_cast<int>(split), rule.production);
+                    }
+                }
+            }
+            prune(cell);
+        }
+    }
+
+    const ViterbiEntry &root = chart[cellIndex(0, n) * variables + grammar.start];
+    if (root.score == impossible) {
+        return result;
+    }
+    result.found = true;
+    result.log_probability = root.score;
+    result.probability = std::exp(root.score);
+
+    // Follow the back pointers
+    struct Frame {
+        std::size_t i;
+        std::size_t length;
+        int variable;
+        ParseTree *node;
+    };
+    std::vector<Frame> stack{{0, n, grammar.start, &result.tree}};
+    while (!stack.empty()) {
+        Frame frame = stack.back();
+        stack.pop_back();
+        const ViterbiEntry &entry = chart[cellIndex(frame.i, frame.length) * variables + frame.variable];
+        frame.node->symbol = indexed.symbols[frame.variable];
+        const auto &body = indexed.bodies[entry.rule];
+        if (entry.split == 0) {
+            frame.node->children.push_back({indexed.symbols[body[0]], {}});
+            continue;
+        }
+        frame.node->children.resize(2);
+        std::size_t split = entry.split;
+        stack.push_back({frame.i, split, body[0], &frame.node->children[0]});
+        stack.push_back({frame.i + split, frame.length - split, body[1], &frame.node->children[1]});
+    }
+    return result;
+}
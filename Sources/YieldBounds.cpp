@@ -0,0 +1,183 @@
+//
+// Created by 2005e on 18/10/2026.
+//
+
+#include <algorithm>
+
+#include "../Headers/YieldBounds.h"
+
+namespace {
+    std::size_t saturatingAdd(std::size_t a, std::size_t b) {
+        return a > YieldBounds::infinite - b ? YieldBounds::infinite : a + b;
+    }
+}
+
+YieldBounds::YieldBounds(const IndexedGrammar &grammar) {
+    const std::size_t symbol_count = grammar.symbols.size();
+    const std::size_t production_count = grammar.heads.size();
+    min.assign(symbol_count, infinite);
+    max.assign(symbol_count, 0);
+    for (std::size_t symbol = grammar.variable_count; symbol < symbol_count; symbol++) {
+        min[symbol] = 1;
+        max[symbol] = 1;
+    }
+
+    // Shortest derivations
+    bool changed = true;
+    while (changed) {
+        changed = false;
+        for (std::size_t p = 0; p < production_count; p++) {
+            std::size_t length = 0;
+            for (int symbol: grammar.bodies[p]) {
+                length = saturatingAdd(length, min[symbol]);
+            }
+            if (length < min[grammar.heads[p]]) {
+                min[grammar.heads[p]] = length;
+                changed = true;
+            }
+        }
+    }
+
+    // Only the productions whose symbols all derive a string take part in the maximum
+    std::vector<bool> productive(production_count);
+    for (std::size_t p = 0; p < production_count; p++) {
+        productive[p] = std::all_of(grammar.bodies[p].begin(), grammar.bodies[p].end(), [this](int symbol) {
+            return min[symbol] != infinite;
+        });
+    }
+    // A symbol is solid if it derives a non-empty string
+    std::vector<bool> solid(symbol_count, false);
+    std::fill(solid.begin() + grammar.variable_count, solid.end(), true);
+    changed = true;
+    while (changed) {
+        changed = false;
+        for (std::size_t p = 0; p < production_count; p++) {
+            if (productive[p] && !solid[grammar.heads[p]] &&
+                std::any_of(grammar.bodies[p].begin(), grammar.bodies[p].end(), [&solid](int symbol) {
+                    return solid[symbol];
+                })) {
+                solid[grammar.heads[p]] = true;
+                changed = true;
+            }
+        }
+    }
+
+    // Strongly connected components of the variables (iterative Tarjan), they are completed in reverse topological order
+    const int variable_count = grammar.variable_count;
+    std::vector<int> index(variable_count, -1);
+    std::vector<int> low(variable_count, 0);
+    std::vector<int> component(variable_count, -1);
+    std::vector<bool> on_stack(variable_count, false);
+    std::vector<int> stack;
+    std::vector<std::vector<int>> components;
+    int counter = 0;
+    // Frames of the DFS: the variable and the position in its list of (production, body position) edges
+    std::vector<std::pair<int, std::size_t>> frames;
+    auto successors = [&grammar, &productive](int variable) {
+        std::vector<int> result;
+        for (int production: grammar.rules[variable]) {
+            if (productive[production]) {
+                for (int symbol: grammar.bodies[production]) {
+                    if (grammar.isVariable(symbol)) {
+                        result.push_back(symbol);
+                    }
+                }
+            }
+        }
+        return result;
+    };
+    std::vector<std::vector<int>> edges(variable_count);
+    for (int variable = 0; variable < variable_count; variable++) {
+        edges[variable] = successors(variable);
+    }
+    for (int root = 0; root < variable_count; root++) {
+        if (index[root] != -1) {
+            continue;
+        }
+        frames.emplace_back(root, 0);
+        index[root] = low[root] = counter++;
+        stack.push_back(root);
+        on_stack[root] = true;
+        while (!frames.empty()) {
+            auto &[variable, next] = frames.back();
+            if (next < edges[variable].size()) {
+                int successor = edges[variable][next++];
+                if (index[successor] == -1) {
+                    index[successor] = low[successor] = counter++;
+                    stack.push_back(successor);
+                    on_stack[successor] = true;
+                    frames.emplace_back(successor, 0);
+                } else if (on_stack[successor]) {
+                    low[variable] = std::min(low[variable], index[successor]);
+                }
+                continue;
+            }
+            int finished = variable;
+            frames.pop_back();
+            if (!frames.empty()) {
+                low[frames.back().first] = std::min(low[frames.back().first], low[finished]);
+            }
+            if (low[finished] == index[finished]) {
+                components.emplace_back();
+                int member;
+                do {
+                    member = stack.back();
+                    stack.pop_back();
+                    on_stack[member] = false;
+                    component[member] = static_cast<int>(components.size()) - 1;
+                    components.back().push_back(member);
+                } while (member != finished);
+            }
+        }
+    }
+
+    // Longest derivations, the components below a component are already done
+    for (std::size_t c = 0; c < components.size(); c++) {
+        const auto &members = components[c];
+        bool unbounded = false;
+        for (int variable: members) {
+            for (int production: grammar.rules[variable]) {
+                if (!productive[production]) {
+                    continue;
+                }
+                const auto &body = grammar.bodies[production];
+                for (std::size_t position = 0; position < body.size() && !unbounded; position++) {
+                    if (!grammar.isVariable(body[position]) || component[body[position]] != static_cast<int>(c)) {
+                        continue;
+                    }
+                    for (std::size_t other = 0; other < body.size(); other++) {
+                        if (other != position && solid[body[other]]) {
+                            unbounded = true;
+                            break;
+                        }
+                    }
+                }
+            }
+        }
+        if (!unbounded) {
+            // Inside the component only empty strings are added, so |members| rounds reach the fixed point
+            for (std::size_t round = 0; round <= members.size(); round++) {
+                for (int variable: members) {
+                    for (int production: grammar.rules[variable]) {
+                        if (!productive[production]) {
+                            continue;
+                        }
+                        std::size_t length = 0;
+                        for (int symbol: grammar.bodies[production]) {
+                            length = saturatingAdd(length, max[symbol]);
+                        }
+                        max[variable] = std::max(max[variable], length);
+                    }
+                }
+            }
+        }
+        for (int variable: members) {
+            if (unbounded) {
+                max[variable] = infinite;
+            }
+            if (min[variable] == infinite) {
+                max[variable] = 0;
+            }
+        }
+    }
+}
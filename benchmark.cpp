@@ -0,0 +1,191 @@
+#include <chrono>
+#include <cstring>
+#include <functional>
+#include <random>
+
+#ifdef __linux__
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+#include "Headers/CFG.h"
+#include "Headers/BitsetCYK.h"
+#include "Headers/TiledCYK.h"
+#include "Headers/ValiantRecognizer.h"
+
+using namespace std;
+
+/**
+ * A small CNF grammar for balanced strings over a (open) and b (close)
+ */
+CFG balancedGrammar() {
+    CFG cfg;
+    cfg.setTerminals({"a", "b"});
+    cfg.setStartSymbol("S");
+    for (const auto &variable: {"S", "A", "B", "X"}) {
+        cfg.addVariable(variable);
+    }
+    cfg.addProductionRule("S", "A B");
+    cfg.addProductionRule("S", "A X");
+    cfg.addProductionRule("S", "S S");
+    cfg.addProductionRule("X", "S B");
+    cfg.addProductionRule("A", "a");
+    cfg.addProductionRule("B", "b");
+    return cfg;
+}
+
+/**
+ * A random balanced string of the given (even) length
+ */
+string balancedString(size_t length, mt19937 &generator) {
+    string result;
+    size_t depth = 0;
+    for (size_t i = 0; i < length; i++) {
+        bool open = depth == 0 || (length - i > depth && generator() % 2);
+        result += open ? 'a' : 'b';
+        open ? depth++ : depth--;
+    }
+    return result;
+}
+
+/**
+ * Repeats a call until at least 0.1 seconds have passed
+ * @return the average time of one call in seconds
+ */
+double seconds(const function<bool()> &run, bool &result) {
+    auto start = chrono::steady_clock::now();
+    size_t repetitions = 0;
+    double elapsed;
+    do {
+        result = run();
+        repetitions++;
+        elapsed = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+    } while (elapsed < 0.1);
+    return elapsed / static_cast<double>(repetitions);
+}
+
+/**
+ * Counts the last level cache misses of a call with perf_event_open
+ * @return the number of misses, -1 if the counter is not available
+ */
+long long cacheMisses(const function<bool()> &run, bool &result) {
+#ifdef __linux__
+    perf_event_attr attributes{};
+    attributes.type = PERF_TYPE_HARDWARE;
+    attributes.size = sizeof(attributes);
+    attributes.config = PERF_COUNT_HW_CACHE_MISSES;
+    attributes.disabled = 1;
+    attributes.exclude_kernel = 1;
+    attributes.exclude_hv = 1;
+    int fd = static_cast<int>(syscall(SYS_perf_event_open, &attributes, 0, -1, -1, 0));
+    if (fd >= 0) {
+        ioctl(fd, PERF_EVENT_IOC_RESET, 0);
+        ioctl(fd, PERF_EVENT_IOC_ENABLE, 0);
+        result = run();
+        ioctl(fd, PERF_EVENT_IOC_DISABLE, 0);
+        long long misses = 0;
+        if (read(fd, &misses, sizeof(misses)) != sizeof(misses)) {
+            misses = -1;
+        }
+        close(fd);
+        return misses;
+    }
+#endif
+    result = run();
+    return -1;
+}
+
+/**
+ * Finds the input length from which Valiant's algorithm beats bitset CYK
+ */
+void benchmarkValiant(size_t max_length, double cyk_limit) {
+    CFG cfg = balancedGrammar();
+    BitsetCYK cyk(cfg);
+    ValiantRecognizer valiant(cfg);
+    mt19937 generator(42);
+
+    cout << ">>> CYK vs Valiant (balanced strings, 4 variables)" << endl;
+    cout << setw(8) << "n" << setw(14) << "CYK (s)" << setw(14) << "Valiant (s)" << setw(10) << "speedup" << endl;
+    size_t crossover = 0;
+    bool cyk_enabled = true;
+    for (size_t length = 4; length <= max_length; length *= 2) {
+        string input = balancedString(length, generator);
+        bool valiant_result;
+        double valiant_time = seconds([&] { return valiant.accepts(input); }, valiant_result);
+        cout << setw(8) << length;
+        if (cyk_enabled) {
+            bool cyk_result;
+            double cyk_time = seconds([&] { return cyk.accepts(input); }, cyk_result);
+            if (cyk_result != valiant_result) {
+                cerr << "results differ for n = " << length << endl;
+                exit(1);
+            }
+            if (crossover == 0 && valiant_time < cyk_time) {
+                crossover = length;
+            }
+            cyk_enabled = cyk_time < cyk_limit;
+            cout << setw(14) << cyk_time << setw(14) << valiant_time << setw(10) << cyk_time / valiant_time << endl;
+        } else {
+            cout << setw(14) << "-" << setw(14) << valiant_time << setw(10) << "-" << endl;
+        }
+    }
+    if (crossover) {
+        cout << " >> Valiant is faster from n = " << crossover << endl;
+    }
+}
+
+/**
+ * Compares the diagonal order of bitset CYK with the tiled order: time, throughput (splits per second)
+ * and last level cache misses
+ */
+void benchmarkTiled(size_t max_length, double cyk_limit) {
+    CFG cfg = balancedGrammar();
+    BitsetCYK cyk(cfg);
+    TiledCYK tiled(cfg);
+    mt19937 generator(42);
+
+    cout << ">>> CYK vs tiled CYK (balanced strings, 4 variables)" << endl;
+    cout << setw(8) << "n" << setw(12) << "CYK (s)" << setw(12) << "tiled (s)" << setw(16) << "CYK splits/s"
+         << setw(16) << "tiled splits/s" << setw(14) << "CYK misses" << setw(14) << "tiled misses" << endl;
+    for (size_t length = 1000; length <= max_length; length *= 2) {
+        string input = balancedString(length, generator);
+        double splits = static_cast<double>(length) * length * length / 6.0;
+        bool cyk_result, tiled_result;
+        auto start = chrono::steady_clock::now();
+        long long cyk_misses = cacheMisses([&] { return cyk.accepts(input); }, cyk_result);
+        double cyk_time = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+        start = chrono::steady_clock::now();
+        long long tiled_misses = cacheMisses([&] { return tiled.accepts(input); }, tiled_result);
+        double tiled_time = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+        if (cyk_result != tiled_result) {
+            cerr << "results differ for n = " << length << endl;
+            exit(1);
+        }
+        auto misses = [](long long count) {
+            return count < 0 ? string("n/a") : to_string(count);
+        };
+        cout << setw(8) << length << setw(12) << cyk_time << setw(12) << tiled_time << setw(16) << splits / cyk_time
+             << setw(16) << splits / tiled_time << setw(14) << misses(cyk_misses) << setw(14) << misses(tiled_misses)
+             << endl;
+        if (cyk_time > cyk_limit || tiled_time > cyk_limit) {
+            break;
+        }
+    }
+}
+
+int main(int argc, char *argv[]) {
+
+    // Usage: benchmark [valiant|tiled] [max_length] [time_limit_in_seconds]
+    string mode = argc > 1 ? argv[1] : "all";
+    double limit = argc > 3 ? stod(argv[3]) : 20.0;
+
+    if (mode == "valiant" || mode == "all") {
+        benchmarkValiant(argc > 2 ? stoul(argv[2]) : 16384, limit);
+    }
+    if (mode == "tiled" || mode == "all") {
+        benchmarkTiled(argc > 2 ? stoul(argv[2]) : 20000, limit);
+    }
+    return 0;
+}